@@ -0,0 +1,78 @@
+#ifndef ggMatrixElements_AmplitudeTables_h
+#define ggMatrixElements_AmplitudeTables_h
+
+#include <CepGen/Core/ParametersDescription.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "CepGenEPA/HelicityAmplitudes.h"
+
+/// Memory-mapped interpolation tables of the fermion and vector loop helicity amplitudes in the exact region,
+/// bicubically interpolated in (log sred, cos theta), with cos theta = 1 + 2 tred / sred
+/// \note Each cell is validated against the exact evaluation (at its centre and edges midpoints) at generation
+///   time; cells exceeding the interpolation tolerance (e.g. around the sred = 1 threshold) are flagged for an
+///   exact evaluation fallback
+class AmplitudeTables {
+public:
+  /// Tables binning and accuracy requirements
+  struct Binning {
+    uint64_t num_log_s{1000};      ///< number of nodes in log(sred)
+    uint64_t num_cos_theta{500};   ///< number of nodes in cos(theta)
+    double s_min{1.e-3};           ///< minimal reduced sred tabulated
+    double s_max{1.e9};            ///< maximal reduced sred tabulated
+    double cos_theta_max{0.9998};  ///< maximal |cos(theta)| tabulated
+    double tolerance{1.e-6};       ///< interpolation error allowed, relative to the largest amplitude
+  };
+
+  /// Memory-map an existing tables file
+  explicit AmplitudeTables(const std::string& path);
+  ~AmplitudeTables();
+  AmplitudeTables(const AmplitudeTables&) = delete;
+  AmplitudeTables& operator=(const AmplitudeTables&) = delete;
+
+  /// Evaluate the exact amplitudes on the tables nodes, validate each cell, and store the tables into a file
+  static void generate(const std::string& path, const Binning&);
+  /// Build (and generate if requested or missing) the tables from user-steered parameters
+  /// \return a null pointer if no tables path is provided
+  static std::shared_ptr<const AmplitudeTables> build(const cepgen::ParametersList&);
+  static cepgen::ParametersDescription description();
+
+  /// Interpolated fermion loop amplitudes, if (sred, tred) lies in a validated cell
+  std::optional<HelicityAmplitudes> fermion(double sred, double tred) const;
+  /// Interpolated vector loop amplitudes, if (sred, tred) lies in a validated cell
+  std::optional<HelicityAmplitudes> vector(double sred, double tred) const;
+
+  inline const Binning& binning() const { return header_->binning; }
+  /// Fraction of the cells for which interpolated values are used
+  double validFraction() const;
+
+  /// Tabulated amplitudes at a node
+  struct Node {
+    std::complex<double> fermion[5];  ///< fermion loop amplitudes (++++, +--+, +-+-, +++-, ++--)
+    std::complex<double> vector[3];   ///< vector loop amplitudes (++++, +--+, +-+-), others are -3/2 x fermion ones
+  };
+  /// Tables file header
+  struct Header {
+    static constexpr uint32_t goodMagic() { return 0xa4a4ab1e; }
+    uint32_t magic_number;
+    uint32_t node_size;  ///< size of a node record, to check the file layout consistency
+    Binning binning;
+  };
+  enum CellValidity : uint8_t { invalid = 0, fermion_valid = 0x1, vector_valid = 0x2 };
+
+private:
+  /// Locate the cell and the position within it, if the point lies in a cell validated for this loop type
+  bool locate(double sred, double tred, uint8_t validity, size_t& is, size_t& ic, double& fs, double& fc) const;
+
+  size_t size_{0};
+  void* data_{nullptr};
+  const Header* header_{nullptr};
+  const Node* nodes_{nullptr};
+  const uint8_t* cells_{nullptr};
+  double log_s_min_{0.}, inv_log_s_step_{0.}, inv_cos_theta_step_{0.};
+};
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef ggMatrixElements_Dilogarithm_h
+#define ggMatrixElements_Dilogarithm_h
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+namespace cepgen::epa::utils {
+  namespace dilogarithm {
+    constexpr double kZeta2 = M_PI * M_PI / 6.;  ///< Li2(1) = pi^2/6
+
+    /// Bernoulli series Li2(z) = sum_n B_n u^(n+1)/(n+1)!, with u = -log(1-z), converging for |u| < 2pi
+    template <typename T>
+    inline T bernoulliSeries(const T& u) {
+      // B_n/(n+1)! coefficients beyond the linear term (odd Bernoulli numbers beyond B_1 vanish)
+      constexpr double b[] = {-1. / 4.,
+                              +1. / 36.,
+                              -1. / 3600.,
+                              +1. / 211680.,
+                              -1. / 10886400.,
+                              +1. / 526901760.,
+                              -4.0647616451442255e-11,
+                              +8.9216910204564526e-13,
+                              -1.9939295860721076e-14,
+                              +4.5189800296199182e-16};
+      const T u2 = u * u;
+      T sum = b[9];  // Horner scheme over the even powers of u
+      for (int i = 8; i > 0; --i)
+        sum = b[i] + u2 * sum;
+      return u + u2 * (b[0] + u * sum);
+    }
+  }  // namespace dilogarithm
+
+  /// Real part of the dilogarithm Li2(x), for any real x (principal branch for x > 1)
+  inline double dilog(double x) {
+    using dilogarithm::bernoulliSeries;
+    using dilogarithm::kZeta2;
+    // map the argument into [-1, 1/2], where |log(1-x)| <= log(2)
+    if (x < -1.) {  // Li2(x) = -Li2(1/x) - pi^2/6 - log^2(-x)/2
+      const auto l = std::log(-x);
+      return -bernoulliSeries(-std::log1p(-1. / x)) - kZeta2 - 0.5 * l * l;
+    }
+    if (x <= 0.5)
+      return bernoulliSeries(-std::log1p(-x));
+    if (x < 1.)  // Li2(x) = -Li2(1-x) + pi^2/6 - log(x) log(1-x)
+      return -bernoulliSeries(-std::log(x)) + kZeta2 - std::log(x) * std::log1p(-x);
+    if (x == 1.)
+      return kZeta2;
+    if (x <= 2.) {  // Re Li2(x) = -Li2(1-x) + pi^2/6 - log(x) log(x-1)
+      const auto l = std::log(x);
+      return -bernoulliSeries(-l) + kZeta2 - l * std::log(x - 1.);
+    }
+    // Re Li2(x) = -Li2(1/x) + pi^2/3 - log^2(x)/2
+    const auto l = std::log(x);
+    return -bernoulliSeries(-std::log1p(-1. / x)) + 2. * kZeta2 - 0.5 * l * l;
+  }
+
+  /// Complex dilogarithm Li2(z), with the cut along z > 1 approached from above
+  inline std::complex<double> dilog(const std::complex<double>& z) {
+    using dilogarithm::bernoulliSeries;
+    using dilogarithm::kZeta2;
+    const auto re = std::real(z), im = std::imag(z);
+    if (im == 0.)
+      return {dilog(re), re > 1. ? M_PI * std::log(re) : 0.};
+    const auto norm = std::norm(z);
+    if (re <= 0.5) {
+      if (norm <= 1.)
+        return bernoulliSeries(-std::log(1. - z));
+      // Li2(z) = -Li2(1/z) - pi^2/6 - log^2(-z)/2
+      const auto l = std::log(-z);
+      return -bernoulliSeries(-std::log(1. - 1. / z)) - kZeta2 - 0.5 * l * l;
+    }
+    if (norm <= 2. * re) {  // |1-z| <= 1: Li2(z) = -Li2(1-z) + pi^2/6 - log(z) log(1-z)
+      const auto l = std::log(z);
+      return -bernoulliSeries(-l) + kZeta2 - l * std::log(1. - z);
+    }
+    const auto l = std::log(-z);
+    return -bernoulliSeries(-std::log(1. - 1. / z)) - kZeta2 - 0.5 * l * l;
+  }
+
+  /// Real part of the dilogarithm for a batch of real arguments
+  inline void dilog(const std::vector<double>& x, std::vector<double>& output) {
+    output.resize(x.size());
+    for (size_t i = 0; i < x.size(); ++i)
+      output[i] = dilog(x[i]);
+  }
+
+  /// Complex dilogarithm for a batch of complex arguments
+  inline void dilog(const std::vector<std::complex<double> >& z, std::vector<std::complex<double> >& output) {
+    output.resize(z.size());
+    for (size_t i = 0; i < z.size(); ++i)
+      output[i] = dilog(z[i]);
+  }
+}  // namespace cepgen::epa::utils
+
+#endif
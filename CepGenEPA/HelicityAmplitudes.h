@@ -5,9 +5,116 @@
 #define ggMatrixElements_HelicityAmplitudes_h
 
 #include <complex>
+#include <vector>
 
 int limits(double sred, double tred);
 
+class AmplitudeTables;
+
+/// Independent helicity configurations of the light-by-light scattering amplitudes
+enum struct Helicity { pppp, pmmp, pmpm, pppm, ppmm };
+/// Loop contributions included in the amplitudes, following the exclude_loops integer convention
+enum struct Loops { all = 0, no_fermion = 1, no_vector = 2, none = 3 };
+constexpr bool hasFermionLoops(Loops loops) { return loops == Loops::all || loops == Loops::no_vector; }
+constexpr bool hasVectorLoops(Loops loops) { return loops == Loops::all || loops == Loops::no_fermion; }
+
+/// Set of all independent helicity amplitudes for a given phase space point
+struct HelicityAmplitudes {
+  HelicityAmplitudes& operator+=(const HelicityAmplitudes&);
+  HelicityAmplitudes& operator*=(double);
+  friend HelicityAmplitudes operator*(double factor, HelicityAmplitudes amplitudes) { return amplitudes *= factor; }
+
+  /// Amplitude for a compile-time helicity configuration
+  template <Helicity H>
+  const std::complex<double>& get() const {
+    if constexpr (H == Helicity::pppp)
+      return pppp;
+    else if constexpr (H == Helicity::pmmp)
+      return pmmp;
+    else if constexpr (H == Helicity::pmpm)
+      return pmpm;
+    else if constexpr (H == Helicity::pppm)
+      return pppm;
+    else
+      return ppmm;
+  }
+
+  std::complex<double> pppp, pmmp, pmpm, pppm, ppmm;
+};
+
+/// Compute all fermion loop helicity amplitudes, sharing the loop functions evaluation
+/// \param[in] tables optional interpolation tables used in place of the exact evaluation whenever validated
+HelicityAmplitudes Mall_fermion(double sred, double tred, int exclude_loops, const AmplitudeTables* tables = nullptr);
+/// Compute all vector loop helicity amplitudes, sharing the loop functions evaluation
+/// \param[in] tables optional interpolation tables used in place of the exact evaluation whenever validated
+HelicityAmplitudes Mall_vector(double sred, double tred, int exclude_loops, const AmplitudeTables* tables = nullptr);
+/// Fermion loop amplitude for a compile-time helicity configuration and loops content
+/// \note Only the loop functions entering this helicity configuration are evaluated
+template <Helicity H, Loops L = Loops::all>
+std::complex<double> M_fermion(double sred, double tred, const AmplitudeTables* tables = nullptr);
+/// Vector loop amplitude for a compile-time helicity configuration and loops content
+/// \note Only the loop functions entering this helicity configuration are evaluated
+template <Helicity H, Loops L = Loops::all>
+std::complex<double> M_vector(double sred, double tred, const AmplitudeTables* tables = nullptr);
+/// Compute the fermion and vector loop helicity amplitudes without any asymptotic limit
+void Mall_exact(double sred, double tred, HelicityAmplitudes& fermion, HelicityAmplitudes& vector);
+
+/// Helicity amplitudes of a single loop particle at a fixed reduced centre-of-mass energy sred
+/// \note All sred-only quantities (loop functions, forward and backward limits, region thresholds) are evaluated
+///   once at construction, and shared by all subsequent tred evaluations
+class LoopSlice {
+public:
+  enum struct Particle { fermion, vector };
+  /// \param[in] tables optional interpolation tables used in place of the exact evaluation whenever validated
+  explicit LoopSlice(Particle, double sred, int exclude_loops, const AmplitudeTables* tables = nullptr);
+
+  /// Helicity amplitudes at a given reduced momentum transfer tred
+  HelicityAmplitudes operator()(double tred) const;
+
+  /// Is this loop in its low-energy (EFT) limit, whatever the tred value?
+  inline bool lowEnergy() const { return low_; }
+  /// Polynomial coefficients of the low-energy limit amplitudes
+  struct LowEnergyCoefficients {
+    double c{0.};       ///< M++++ = c sred^2, M+--+ = c tred^2, M+-+- = c ured^2
+    double c_ppmm{0.};  ///< M++-- = c_ppmm (sred^2 + tred^2 + ured^2), M+++- = 0
+  };
+  LowEnergyCoefficients lowEnergyCoefficients() const;
+
+private:
+  Particle particle_;
+  double sred_;
+  int exclude_loops_;
+  const AmplitudeTables* tables_;
+  bool excluded_;
+  bool low_, high_;
+  double forward_max_t_, backward_max_u_;
+  std::complex<double> b_s_, t_s_;
+  HelicityAmplitudes forward_, backward_;
+};
+
+/// Accumulate the fermion loop helicity amplitudes for a batch of (s, t) points
+/// \param[in] scale conversion factor from (s, t) to the reduced (sred, tred) variables, 1/(4m^2)
+/// \param[in] weight multiplicative factor applied to this loop contribution
+/// \param[in] tables optional interpolation tables used in place of the exact evaluation whenever validated
+void Mall_fermion(const std::vector<double>& s,
+                  const std::vector<double>& t,
+                  double scale,
+                  double weight,
+                  int exclude_loops,
+                  std::vector<HelicityAmplitudes>& output,
+                  const AmplitudeTables* tables = nullptr);
+/// Accumulate the vector loop helicity amplitudes for a batch of (s, t) points
+/// \param[in] scale conversion factor from (s, t) to the reduced (sred, tred) variables, 1/(4m^2)
+/// \param[in] weight multiplicative factor applied to this loop contribution
+/// \param[in] tables optional interpolation tables used in place of the exact evaluation whenever validated
+void Mall_vector(const std::vector<double>& s,
+                 const std::vector<double>& t,
+                 double scale,
+                 double weight,
+                 int exclude_loops,
+                 std::vector<HelicityAmplitudes>& output,
+                 const AmplitudeTables* tables = nullptr);
+
 std::complex<double> Mxxxx_fermion(double x, double y);
 std::complex<double> Mpppp_fermion(double sred, double tred, int exclude_loops);
 std::complex<double> Mpmmp_fermion(double sred, double tred, int exclude_loops);
@@ -22,6 +129,11 @@ std::complex<double> Mpmpm_vector(double sred, double tred, int exclude_loops);
 std::complex<double> Mpppm_vector(double sred, double tred, int exclude_loops);
 std::complex<double> Mppmm_vector(double sred, double tred, int exclude_loops);
 
+/// Helicity amplitudes for the exchange of a CP-even spin-0 resonance, as functions of (x, y) = (s, t)
+/// \param[in] m resonance mass
+/// \param[in] f0 resonance coupling scale to photons
+/// \param[in] w_const resonance width in addition to its diphoton partial width
+/// \param[in] a2 squared scale of the a2 / (a2 + |x|) form factor (disabled if non-positive)
 std::complex<double> Mxxxx_spin0even(double x, double y, double m, double f0, double w_const, double a2);
 std::complex<double> Mpppp_spin0even(double x, double y, double m, double f0, double w_const, double a2);
 std::complex<double> Mpmmp_spin0even(double x, double y, double m, double f0, double w_const, double a2);
@@ -0,0 +1,77 @@
+/*
+ *  CepGen: a central exclusive processes event generator
+ *  Copyright (C) 2026  Laurent Forthomme
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CepGenEPA_IntegratorPool_h
+#define CepGenEPA_IntegratorPool_h
+
+#include <CepGen/Core/ParametersList.h>
+#include <CepGen/Integration/Integrator.h>
+#include <CepGen/Modules/IntegratorFactory.h>
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace cepgen::epa {
+  /// Set of identical integrators, each lent to a single thread at a time
+  /// \note Integrators hold a mutable workspace, and may not be used concurrently; modules shared across threads
+  ///   (see SharedModules) hence borrow an idle integrator for each integration, building a new one only if all
+  ///   others are in use, so that the pool grows to the number of concurrent users
+  class IntegratorPool {
+  public:
+    explicit IntegratorPool(const ParametersList& integrator) : integrator_(integrator) {
+      idle_.emplace_back(IntegratorFactory::get().build(integrator_));  // validate the parameters at construction
+    }
+
+    /// Integrate a function with an integrator not used by any other thread
+    template <typename... Args>
+    double integrate(Args&&... args) const {
+      const Loan loan(*this);
+      return loan.integrator->integrate(std::forward<Args>(args)...);
+    }
+
+  private:
+    /// Integrator borrowed from the pool for the lifetime of this object
+    struct Loan {
+      explicit Loan(const IntegratorPool& pool) : pool(pool) {
+        {
+          std::lock_guard<std::mutex> lock(pool.mutex_);
+          if (!pool.idle_.empty()) {
+            integrator = std::move(pool.idle_.back());
+            pool.idle_.pop_back();
+          }
+        }
+        if (!integrator)  // built outside the lock, as other threads may return theirs meanwhile
+          integrator = IntegratorFactory::get().build(pool.integrator_);
+      }
+      ~Loan() {
+        std::lock_guard<std::mutex> lock(pool.mutex_);
+        pool.idle_.emplace_back(std::move(integrator));
+      }
+      const IntegratorPool& pool;
+      std::unique_ptr<Integrator> integrator;
+    };
+
+    const ParametersList integrator_;
+    mutable std::mutex mutex_;
+    mutable std::vector<std::unique_ptr<Integrator> > idle_;  ///< integrators not currently lent
+  };
+}  // namespace cepgen::epa
+
+#endif
@@ -0,0 +1,44 @@
+/*
+ *  CepGen: a central exclusive processes event generator
+ *  Copyright (C) 2026  Laurent Forthomme
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CepGenEPA_InverseCDF_h
+#define CepGenEPA_InverseCDF_h
+
+#include <vector>
+
+namespace cepgen::epa {
+  /// Inverse cumulative distribution of a tabulated non-negative density, linearly interpolated between its nodes
+  class InverseCDF {
+  public:
+    /// \param[in] x strictly increasing nodes
+    /// \param[in] density non-negative density values at the nodes
+    explicit InverseCDF(const std::vector<double>& x, const std::vector<double>& density);
+
+    /// Integral of the interpolated density over the nodes range
+    inline double integral() const { return cumulative_.back(); }
+    /// Node variable value for which the cumulative distribution reaches a fraction u in [0, 1]
+    double operator()(double u) const;
+    /// Interpolated density at a given node variable value
+    double density(double x) const;
+
+  private:
+    std::vector<double> x_, density_, cumulative_;
+  };
+}  // namespace cepgen::epa
+
+#endif
@@ -0,0 +1,46 @@
+/*
+ *  CepGen: a central exclusive processes event generator
+ *  Copyright (C) 2026  Laurent Forthomme
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CepGenEPA_MappedFile_h
+#define CepGenEPA_MappedFile_h
+
+#include <cstddef>
+#include <string>
+
+namespace cepgen::epa {
+  /// Read-only memory mapping of a whole file, whose pages are shared by all processes mapping the same file
+  /// \note Mapped files may only be replaced (e.g. renamed over), never rewritten in place, as their mapped pages
+  ///   would change or vanish under their readers
+  class MappedFile {
+  public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    inline const char* data() const { return static_cast<const char*>(data_); }  ///< First byte of the file
+    inline size_t size() const { return size_; }                                   ///< File size, in bytes
+
+  private:
+    void* data_{nullptr};
+    size_t size_{0};
+  };
+}  // namespace cepgen::epa
+
+#endif
@@ -1,18 +1,142 @@
 #ifndef ggMatrixElements_MatrixElements_h
 #define ggMatrixElements_MatrixElements_h
 
+#include <CepGen/Physics/Constants.h>
+
+#include <array>
 #include <complex>
+#include <memory>
+#include <vector>
+
+#include "CepGenEPA/HelicityAmplitudes.h"
 
 namespace sm_aaaa {
+  /// Immutable content of the light-by-light scattering loops
+  class LoopContext {
+  public:
+    /// Fermion running in the loop
+    struct Fermion {
+      double mass;    ///< fermion mass, in GeV
+      double weight;  ///< number of colours times the fourth power of the electric charge
+    };
+    /// \param[in] tables optional interpolation tables for the loop amplitudes in the exact region
+    explicit LoopContext(const std::vector<Fermion>& fermions,
+                         double vector_mass,
+                         std::shared_ptr<const AmplitudeTables> tables = nullptr);
+
+    /// SM loop content: (e, mu, tau, u, c, t, d, s, b) fermions and the W boson
+    static LoopContext standardModel(std::shared_ptr<const AmplitudeTables> tables = nullptr);
+
+    /// Contribution of one fermion loop to the amplitudes
+    struct FermionLoop {
+      double scale;   ///< conversion factor from (s, t) to the reduced (sred, tred) variables, 1/(4m^2)
+      double weight;  ///< number of colours times the fourth power of the electric charge
+    };
+    inline const std::vector<FermionLoop>& fermionLoops() const { return fermion_loops_; }
+    /// Conversion factor from (s, t) to the reduced variables of the vector loop
+    inline double vectorScale() const { return vector_scale_; }
+    /// Interpolation tables for the loop amplitudes, if any
+    inline const AmplitudeTables* tables() const { return tables_.get(); }
+
+  private:
+    std::vector<FermionLoop> fermion_loops_;
+    double vector_scale_;
+    std::shared_ptr<const AmplitudeTables> tables_;
+  };
+
+  /// SM helicity amplitudes at a fixed centre-of-mass energy, evaluated for many t values
+  /// \note The s-only part of each loop contribution is computed once, at construction. All loops in their
+  ///   low-energy limit (heavy particles at low s) are collapsed into a single polynomial in (s, t, u)
+  class EnergySlice {
+  public:
+    explicit EnergySlice(const LoopContext&, double s, bool exclude_loops = false);
+
+    inline double s() const { return s_; }
+    /// Compute all helicity amplitudes at a given t
+    HelicityAmplitudes amplitudes(double t) const;
+    /// Compute the SM squared matrix element at a given t
+    double sqme(double t) const;
+    /// Compute the SM squared matrix element for a batch of t values
+    void sqme(const std::vector<double>& t, std::vector<double>& output) const;
+
+  private:
+    /// Contribution of one loop particle at this energy
+    struct Loop {
+      double scale;   ///< conversion factor from t to the reduced tred variable
+      double weight;  ///< multiplicative factor applied to this loop contribution
+      LoopSlice slice;
+    };
+    double s_;
+    std::vector<Loop> loops_;                    ///< loops requiring a t-dependent evaluation
+    LoopSlice::LowEnergyCoefficients low_loops_;  ///< summed low-energy limit coefficients, in units of s^-2
+  };
+
   std::complex<double> me_SM(std::complex<double> (*me)(double, double, int),
                              double s,
                              double t,
                              bool exclude_loops = false);
+  /// Compute the complex SM amplitude for a compile-time helicity configuration and loops content
+  template <Helicity H, Loops L = Loops::all>
+  std::complex<double> me_SM(const LoopContext& context, double s, double t) {
+    std::complex<double> output;
+    if constexpr (hasFermionLoops(L))
+      for (const auto& fermion : context.fermionLoops())
+        output += fermion.weight * M_fermion<H, L>(s * fermion.scale, t * fermion.scale, context.tables());
+    if constexpr (hasVectorLoops(L))  // W contribution
+      output += M_vector<H, L>(s * context.vectorScale(), t * context.vectorScale(), context.tables());
+    // the factor of 8 is needed because of the conventions in Costantini, DeTollis, Pistoni
+    return output * (8 * cepgen::constants::ALPHA_EM * cepgen::constants::ALPHA_EM);
+  }
+  /// Compute all helicity amplitudes in a single pass over the loop content
+  HelicityAmplitudes me_SM_all(const LoopContext&, double s, double t, bool exclude_loops = false);
+  /// Compute all helicity amplitudes for a batch of (s, t) points
+  void me_SM_all(const LoopContext&,
+                 const std::vector<double>& s,
+                 const std::vector<double>& t,
+                 std::vector<HelicityAmplitudes>& output,
+                 bool exclude_loops = false);
   double sqme(double s, double t, bool exclude_loops = false);
+  double sqme(const LoopContext&, double s, double t, bool exclude_loops = false);
+  /// Compute the SM squared matrix element for a batch of (s, t) points
+  void sqme_batch(const std::vector<double>& s,
+                  const std::vector<double>& t,
+                  std::vector<double>& output,
+                  bool exclude_loops = false);
+  void sqme_batch(const LoopContext&,
+                  const std::vector<double>& s,
+                  const std::vector<double>& t,
+                  std::vector<double>& output,
+                  bool exclude_loops = false);
 }  // namespace sm_aaaa
 
 namespace eft_aaaa {
   double sqme(double s, double t, bool exclude_loops_SM = false, double zeta1 = 0., double zeta2 = 0.);
-}
+  double sqme(const sm_aaaa::LoopContext&,
+              double s,
+              double t,
+              bool exclude_loops_SM = false,
+              double zeta1 = 0.,
+              double zeta2 = 0.);
+  /// Coefficients of the squared matrix element in the (1, zeta1, zeta2, zeta1^2, zeta2^2, zeta1*zeta2) basis
+  std::array<double, 6> sqmeCoefficients(double s, double t, bool exclude_loops_SM = false);
+  std::array<double, 6> sqmeCoefficients(const sm_aaaa::LoopContext&,
+                                         double s,
+                                         double t,
+                                         bool exclude_loops_SM = false);
+  /// Compute the EFT squared matrix element and SM interference for a batch of (s, t) points
+  void sqme_batch(const std::vector<double>& s,
+                  const std::vector<double>& t,
+                  std::vector<double>& output,
+                  bool exclude_loops_SM = false,
+                  double zeta1 = 0.,
+                  double zeta2 = 0.);
+  void sqme_batch(const sm_aaaa::LoopContext&,
+                  const std::vector<double>& s,
+                  const std::vector<double>& t,
+                  std::vector<double>& output,
+                  bool exclude_loops_SM = false,
+                  double zeta1 = 0.,
+                  double zeta2 = 0.);
+}  // namespace eft_aaaa
 
 #endif
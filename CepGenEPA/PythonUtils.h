@@ -19,13 +19,56 @@
 #ifndef CepGenEPA_PythonUtils_h
 #define CepGenEPA_PythonUtils_h
 
+#include <sys/types.h>
+
 #include <memory>
 #include <string>
+#include <vector>
+
+struct _object;  // Python object, as forward-declared by the Python headers
 
 namespace cepgen::python {
   class Functional;
 
   std::unique_ptr<Functional> make_functional(const std::string& python_name);
+
+  /// Scoped ownership of the Python interpreter lock by the current thread
+  /// \note Python modules may be shared by several threads (see SharedModules), and call into the interpreter with
+  ///   this lock held; it may be nested, e.g. if the calling thread already owns the lock
+  class InterpreterLock {
+  public:
+    InterpreterLock();
+    ~InterpreterLock();
+    InterpreterLock(const InterpreterLock&) = delete;
+    InterpreterLock& operator=(const InterpreterLock&) = delete;
+
+  private:
+    int state_;  ///< interpreter lock state before acquisition, kept opaque to avoid exposing the Python headers
+  };
+
+  /// Fork the current process, keeping the interpreter (if initialised) consistent in both the parent and the child
+  /// \return process identifier as returned by fork(), with its errno preserved
+  pid_t fork();
+
+  /// Python callable evaluated with a single call for a whole batch of values of its first argument
+  /// \note The callable receives the batch as a list, followed by the (scalar) arguments common to all points, and
+  ///   has to return a sequence of the same length (e.g. a list, or a NumPy array)
+  class BatchFunctional {
+  public:
+    explicit BatchFunctional(const std::string& python_name);
+    ~BatchFunctional();
+    BatchFunctional(const BatchFunctional&) = delete;
+    BatchFunctional& operator=(const BatchFunctional&) = delete;
+
+    /// Evaluate the callable for a batch of first argument values, the other arguments being common to all points
+    void operator()(const std::vector<double>& batch,
+                    const std::vector<double>& arguments,
+                    std::vector<double>& values) const;
+
+  private:
+    const std::string python_name_;
+    _object* function_{nullptr};  ///< owned reference to the Python callable
+  };
 }  // namespace cepgen::python
 
 #endif
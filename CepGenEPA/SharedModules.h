@@ -0,0 +1,65 @@
+/*
+ *  CepGen: a central exclusive processes event generator
+ *  Copyright (C) 2026  Laurent Forthomme
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CepGenEPA_SharedModules_h
+#define CepGenEPA_SharedModules_h
+
+#include <CepGen/Core/ParametersList.h>
+
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace cepgen::epa {
+  /// Registry of immutable modules, shared by all their users (e.g. process clones) steering identical parameters
+  /// \note Modules are only kept alive as long as one of their users holds them, and are built under a lock, so that
+  ///   concurrent users requesting the same parameters wait for a single construction
+  /// \note Shared modules may be evaluated concurrently by all threads holding them, and have to be thread-safe (the
+  ///   Python ones taking the interpreter lock for each call)
+  template <typename T>
+  class SharedModules {
+  public:
+    /// Retrieve the module built from a parameters list, or build it using the module factory
+    /// \tparam F module factory type, providing a build(const ParametersList&) method
+    template <typename F>
+    static std::shared_ptr<const T> get(F& factory, const ParametersList& params) {
+      std::ostringstream key;
+      key << params;
+      std::lock_guard<std::mutex> lock(mutex());
+      auto& module = registry()[key.str()];
+      if (auto shared_module = module.lock())
+        return shared_module;
+      std::shared_ptr<const T> shared_module = factory.build(params);
+      module = shared_module;
+      return shared_module;
+    }
+
+  private:
+    static std::mutex& mutex() {
+      static std::mutex mutex;
+      return mutex;
+    }
+    static std::unordered_map<std::string, std::weak_ptr<const T> >& registry() {
+      static std::unordered_map<std::string, std::weak_ptr<const T> > registry;
+      return registry;
+    }
+  };
+}  // namespace cepgen::epa
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef ggMatrixElements_TQuadrature_h
+#define ggMatrixElements_TQuadrature_h
+
+#include <CepGen/Core/ParametersDescription.h>
+
+#include <atomic>
+#include <vector>
+
+/// Fixed-node quadrature of a t <-> u symmetric integrand over t in [-s, 0]
+/// \note Only the forward half-range t in [-s/2, 0] is probed, in a variable x = sqrt(-2t/s) flattening the
+///   forward peak, with Fejer's second (open Clenshaw-Curtis) rule; as the rule of half order uses every second
+///   node, its deviation provides an error estimate at no additional cost
+/// \note Error estimates are accumulated over all integrations, and summarised once at destruction; only the first
+///   integration exceeding the tolerance is reported individually
+class TQuadrature {
+public:
+  explicit TQuadrature(const cepgen::ParametersList&);
+  ~TQuadrature();
+
+  TQuadrature(const TQuadrature&) = delete;
+  TQuadrature& operator=(const TQuadrature&) = delete;
+
+  static cepgen::ParametersDescription description();
+  /// Is this quadrature requested in an integrator parameters block?
+  static bool requested(const cepgen::ParametersList& integrator);
+
+  /// Integration result and its error estimate
+  struct Result {
+    double value{0.};
+    double uncertainty{0.};
+  };
+
+  /// Quadrature nodes for a given s, to be evaluated as a single batch
+  std::vector<double> nodes(double s) const;
+  /// Integrate the integrand values evaluated at the quadrature nodes
+  Result integrate(double s, const std::vector<double>& values) const;
+  /// Number of integrand evaluations per integration
+  inline size_t size() const { return fractions_.size(); }
+  /// Largest relative error estimate over all integrations performed
+  inline double maxRelativeUncertainty() const { return max_relative_uncertainty_; }
+
+private:
+  double relative_tolerance_{0.};
+  std::vector<double> fractions_;       ///< nodes in units of -s
+  std::vector<double> weights_;         ///< full order weights, including the Jacobian and symmetry factors
+  std::vector<double> coarse_weights_;  ///< half order weights, vanishing for odd nodes
+
+  // error estimates statistics, updated concurrently by all users of a shared process
+  mutable std::atomic<size_t> num_integrations_{0};
+  mutable std::atomic<size_t> num_above_tolerance_{0};
+  mutable std::atomic<double> max_relative_uncertainty_{0.};
+};
+
+#endif
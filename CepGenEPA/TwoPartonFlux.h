@@ -21,6 +21,10 @@
 #define CepGenEPA_TwoPartonFlux_h
 
 #include <CepGen/PartonFluxes/PartonFlux.h>
+#include <CepGen/Utils/Limits.h>
+
+#include <algorithm>
+#include <vector>
 
 namespace cepgen::epa {
   /// Base object for a collinear parton flux parameterisation
@@ -36,6 +40,13 @@ namespace cepgen::epa {
 
     virtual std::pair<spdgid_t, spdgid_t> partons() const = 0;  ///< List of partons emitted by the two-beam system
     virtual double flux(double w) const = 0;                    ///< Compute the collinear flux for this point
+    /// Compute the collinear fluxes for a batch of points
+    virtual void fluxes(const std::vector<double>& w, std::vector<double>& values) const {
+      values.resize(w.size());
+      std::transform(w.begin(), w.end(), values.begin(), [this](double w) { return flux(w); });
+    }
+    /// Range of two-parton masses w over which the flux may be non-vanishing (unbounded if undefined)
+    virtual Limits support() const { return Limits{}; }
 
     // replace all PartonFlux pure virtual (and unused) attributes
     inline bool ktFactorised() const final { return false; }
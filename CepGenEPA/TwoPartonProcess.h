@@ -20,6 +20,10 @@
 #define CepGenEPA_TwoPartonProcess_h
 
 #include <CepGen/Modules/NamedModule.h>
+#include <CepGen/Utils/Limits.h>
+
+#include <algorithm>
+#include <vector>
 
 namespace cepgen::epa {
   /// Base object for a collinear two-parton-level process implementation
@@ -38,6 +42,16 @@ namespace cepgen::epa {
     virtual std::string processDescription() const = 0;
     /// Compute the collinear matrix element for this central mass w
     virtual double matrixElement(double w) const = 0;
+    /// Compute the collinear matrix elements for a batch of central masses
+    virtual void matrixElements(const std::vector<double>& w, std::vector<double>& values) const {
+      values.resize(w.size());
+      std::transform(w.begin(), w.end(), values.begin(), [this](double w) { return matrixElement(w); });
+    }
+    /// Range of central masses w over which the matrix element may be non-vanishing (unbounded if undefined)
+    virtual Limits support() const { return Limits{}; }
+    /// May the matrix element be evaluated on a worker thread while the calling thread waits for it?
+    /// \note Implementations calling into an interpreter owned by the calling thread (e.g. Python) may not
+    virtual bool pipelinable() const { return true; }
     /// Retrieve the list of particles produced in the process
     virtual std::vector<int> centralParticles() const { return central_system_particles_; }
 
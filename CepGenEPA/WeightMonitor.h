@@ -0,0 +1,102 @@
+/*
+ *  CepGen: a central exclusive processes event generator
+ *  Copyright (C) 2026  Laurent Forthomme
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CepGenEPA_WeightMonitor_h
+#define CepGenEPA_WeightMonitor_h
+
+#include <CepGen/Utils/Histogram.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cepgen::epa {
+  /// Counters, timers, and weight distribution of the EPA process weight evaluations
+  /// \note Monitors are shared by all process instances (e.g. worker clones) steering the same monitor name, and
+  ///   their summary is printed once the last of its holders is released; retrieve it with get() before the run to
+  ///   keep it alive for a programmatic access afterwards
+  class WeightMonitor {
+  public:
+    ~WeightMonitor();
+
+    /// Retrieve (or create) the monitor registered under a given name
+    static std::shared_ptr<WeightMonitor> get(const std::string& name);
+
+    /// Outcome of a single weight evaluation
+    struct Record {
+      enum struct Status { valid, matrixElementZero, fluxZero };
+      double w{0.};                    ///< two-parton invariant mass
+      double weight{0.};               ///< process weight
+      Status status{Status::valid};    ///< reason for a vanishing weight, if any
+      double matrix_element_time{0.};  ///< time spent in the matrix element evaluation(s), in s
+      double flux_time{0.};            ///< time spent in the parton flux evaluation(s), in s
+    };
+
+    /// Evaluations collected by a single user (e.g. one process instance, hence one thread) without any locking, and
+    /// merged into the monitor by batches, and when released
+    class Accumulator {
+    public:
+      explicit Accumulator(const std::shared_ptr<WeightMonitor>& monitor) : monitor_(monitor) {}
+      ~Accumulator() { flush(); }
+
+      /// Account for one weight evaluation
+      void add(const Record&);
+      /// Merge all evaluations collected since the last merge into the monitor
+      void flush();
+
+    private:
+      static constexpr size_t batch_size_ = 1024;  ///< number of evaluations collected between two merges
+
+      const std::shared_ptr<WeightMonitor> monitor_;
+      unsigned long long calls_{0}, matrix_element_zeros_{0}, flux_zeros_{0};
+      double matrix_element_time_{0.}, flux_time_{0.};
+      std::vector<std::pair<double, double> > weights_;  ///< (w, weight) pairs not yet filled in the distribution
+    };
+
+    /// Book the weights distribution over a w range, if not already booked
+    void book(const Limits& w_range, size_t num_bins = 50);
+    /// Account for one weight evaluation
+    /// \note This call locks the monitor; concurrent users should rather collect their evaluations in an Accumulator
+    void add(const Record&);
+
+    /// Monitor registration name
+    inline const std::string& name() const { return name_; }
+    unsigned long long calls() const;               ///< Number of weight evaluations
+    unsigned long long matrixElementZeros() const;  ///< Number of evaluations with a vanishing matrix element
+    unsigned long long fluxZeros() const;           ///< Number of evaluations with a vanishing flux
+    double matrixElementTime() const;               ///< Cumulative time spent in matrix element evaluations, in s
+    double fluxTime() const;                        ///< Cumulative time spent in flux evaluations, in s
+    utils::Hist1D weights() const;                  ///< Weights distribution as a function of w (once booked)
+
+    /// Human-readable summary of all counters and timers (excluding the evaluations not yet merged by accumulators)
+    std::string summary() const;
+
+  private:
+    explicit WeightMonitor(const std::string& name) : name_(name) {}
+
+    const std::string name_;
+    mutable std::mutex mutex_;
+    unsigned long long calls_{0}, matrix_element_zeros_{0}, flux_zeros_{0};
+    double matrix_element_time_{0.}, flux_time_{0.};
+    std::unique_ptr<utils::Hist1D> weights_;
+  };
+}  // namespace cepgen::epa
+
+#endif
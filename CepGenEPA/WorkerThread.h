@@ -0,0 +1,58 @@
+/*
+ *  CepGen: a central exclusive processes event generator
+ *  Copyright (C) 2026  Laurent Forthomme
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CepGenEPA_WorkerThread_h
+#define CepGenEPA_WorkerThread_h
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace cepgen::epa {
+  /// Persistent thread running the tasks handed off by its owner, one at a time
+  /// \note Unlike a thread launched per task, its creation cost is only paid once, so that short tasks (e.g. a
+  ///   single matrix element evaluation per point) may be offloaded
+  class WorkerThread {
+  public:
+    WorkerThread();
+    ~WorkerThread();
+
+    WorkerThread(const WorkerThread&) = delete;
+    WorkerThread& operator=(const WorkerThread&) = delete;
+
+    /// Start a task on the worker thread, once the previous one is collected with wait()
+    void start(std::function<void()> task);
+    /// Wait for the completion of the current task, rethrowing any exception it raised
+    void wait();
+
+  private:
+    void run();
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::function<void()> task_;
+    bool pending_{false};  ///< is a task started and not yet completed?
+    bool stop_{false};
+    std::exception_ptr error_;  ///< exception raised by the last task, if any
+    std::thread thread_;        ///< started last, once all other members are initialised
+  };
+}  // namespace cepgen::epa
+
+#endif
@@ -20,29 +20,45 @@
 #include <CepGen/Core/Exception.h>
 #include <CepGen/Core/ParametersList.h>
 #include <CepGen/Utils/Filesystem.h>
-#include <CepGen/Utils/GridHandler.h>
+#include <CepGen/Utils/String.h>
 #include <CepGen/Utils/Timer.h>
 #include <CepGen/Version.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iosfwd>
 #include <iostream>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <vector>
 
+#include "CepGenEPA/MappedFile.h"
+#include "CepGenEPA/PythonUtils.h"
 #include "CepGenEPA/TwoPartonFlux.h"
 #include "CepGenEPA/TwoPartonFluxFactory.h"
 
 using namespace cepgen;
 using namespace std::string_literals;
 
-class GridTwoPartonFlux final : public epa::TwoPartonFlux, private GridHandler<1, 1> {
+class GridTwoPartonFlux final : public epa::TwoPartonFlux {
 public:
   explicit GridTwoPartonFlux(const ParametersList& params)
       : epa::TwoPartonFlux(params),
-        GridHandler(GridType::linear),
         grid_path_(steerPath("path")),
         check_header_(steer<bool>("checkHeader")),
+        memory_mapped_(steer<bool>("memoryMapped")),
         header_(params_) {
     if (steer<bool>("generateGrid") || grid_path_.empty() || !utils::fileExists(grid_path_))
       buildGrid();  // grid is not provided by the user, or is empty; build it
@@ -55,13 +71,86 @@ public:
     desc.add("modelling", ParametersDescription()).setDescription("type of flux to use to build the grid");
     desc.add("path", "flux.grid"s).setDescription("path to the interpolation grid");
     desc.add("checkHeader", true).setDescription("check the grid file header before parsing it?");
+    desc.add("memoryMapped", true)
+        .setDescription(
+            "interpolate directly on the read-only memory mapping of the grid file, shared by all processes using it, "
+            "instead of a private copy of its content?");
     desc.add("logW", true);
+    desc.addAs<int, Interpolation>("interpolation", Interpolation::linear)
+        .setDescription(
+            "interpolation scheme between the grid nodes, recorded in the grid header at its construction (0: linear, "
+            "1: linear in log(w)-log(flux), 2: monotone Steffen cubic in log(w)-log(flux))");
     desc.add("generateGrid", false).setDescription("(re-)generate the grid prior to run?");
-    desc.add("numPoints", 500).setDescription("number of points to compute for the grid construction");
+    desc.add("numPoints", 500)
+        .setDescription(
+            "number of points to compute for the grid construction (initial nodes for an adaptive construction)");
+    desc.add("tolerance", 0.)
+        .setDescription(
+            "target relative accuracy of the interpolation for an adaptive grid construction, bisecting the intervals "
+            "whose interpolated midpoint flux deviates from the modelling (disabled if non-positive)");
+    desc.add("absoluteTolerance", 0.)
+        .setDescription(
+            "flux deviation below which an interval is considered converged whatever its relative accuracy, e.g. "
+            "close to the flux zeros (if non-positive, the relative tolerance times the largest initial node flux)");
+    desc.add("minRelativeWidth", 1.e-9)
+        .setDescription("relative width in w below which intervals are no longer bisected in an adaptive construction");
+    desc.add("maxPoints", 10000).setDescription("maximum number of nodes for an adaptive grid construction");
+    desc.add("sqrtSValues", std::vector<double>{})
+        .setDescription(
+            "centre-of-mass energies tabulated in a multi-dimensional grid serving an energy scan, interpolated "
+            "linearly in log(sqrt(s)) at fixed w/sqrt(s); the modelling beam energies are scaled with their ratio "
+            "kept, and the w range with the energy (none if empty)");
+    desc.add("q2maxValues", std::vector<double>{})
+        .setDescription(
+            "maximal parton virtualities of both beams tabulated in a multi-dimensional grid serving a virtuality "
+            "cut scan, interpolated linearly in log(q2max) (none if empty)");
+    desc.add("numWorkers", 1)
+        .setDescription(
+            "number of concurrent workers evaluating the modelling for the grid construction (threads with their own "
+            "modelling instance, or forked processes for Python modellings, bound to the interpreter lock)");
     return desc;
   }
 
-  double flux(double w) const override { return GridHandler<1, 1>::eval({w}).at(0); }
+  double flux(double w) const override {
+    double flux = 0.;
+    for (const auto& slice : slices_)
+      flux += slice.weight * slice.scale * interpolate(slice.nodes, slice.num_nodes, interpolation_, w * slice.scale);
+    return flux;
+  }
+  /// Batch evaluation in a single pass over the nodes of each slice, with the points visited in increasing w
+  void fluxes(const std::vector<double>& w, std::vector<double>& values) const override {
+    values.assign(w.size(), 0.);
+    std::vector<size_t> order(w.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (!std::is_sorted(w.begin(), w.end()))
+      std::sort(order.begin(), order.end(), [&w](size_t i, size_t j) { return w[i] < w[j]; });
+    for (const auto& slice : slices_) {
+      const auto *nodes = slice.nodes, *last = nodes + slice.num_nodes - 1;
+      const auto* upper = nodes + 1;  // cursor only moving forward, as the points are sorted
+      for (const auto i : order) {
+        const auto slice_w = w[i] * slice.scale;
+        if (slice_w < nodes->w)
+          continue;
+        if (slice_w > last->w)
+          break;
+        while (upper < last && upper->w <= slice_w)
+          ++upper;
+        values[i] += slice.weight * slice.scale *
+                     interpolateInInterval(nodes, slice.num_nodes, interpolation_, upper - nodes, slice_w);
+      }
+    }
+  }
+  Limits support() const override {
+    const auto slice_support = [](const Slice& slice) {
+      return Limits{slice.nodes[0].w / slice.scale, slice.nodes[slice.num_nodes - 1].w / slice.scale};
+    };
+    auto support = slice_support(slices_.front());
+    for (const auto& slice : slices_) {
+      support.min() = std::min(support.min(), slice_support(slice).min());
+      support.max() = std::max(support.max(), slice_support(slice).max());
+    }
+    return support;
+  }
 
   inline bool fragmenting() const override { return header_.fragmenting; }
   inline std::pair<spdgid_t, spdgid_t> partons() const override {
@@ -69,6 +158,20 @@ public:
   }
 
 private:
+  enum struct Interpolation { linear = 0, logLog = 1, steffen = 2 };
+  struct GridValue {
+    double w, flux;
+  };
+  /// Nodes of a one-dimensional grid in w, and its weight in the interpolation of a multi-dimensional grid
+  /// \note Slices tabulated for another centre-of-mass energy are probed at the same w/sqrt(s), and their flux
+  ///   rescaled by the Jacobian of this change of variable, so that their kinematic endpoints coincide
+  struct Slice {
+    const GridValue* nodes{nullptr};
+    size_t num_nodes{0};
+    double weight{1.};
+    double scale{1.};  ///< ratio of the slice centre-of-mass energy to the requested one
+  };
+
   inline void buildGrid() {
     const auto modelling = steer<ParametersList>("modelling");
     if (modelling.empty())
@@ -76,48 +179,498 @@ private:
                                                        "'modelling' parameter of this grid interpolator modelling.";
     if (modelling.name() == "grid")
       throw CG_FATAL("GridTwoPartonFlux:buildGrid") << "Cannot build a grid from a grid interpolator.";
-    const auto flux_algorithm = TwoPartonFluxFactory::get().build(modelling);
-    CG_DEBUG("GridTwoPartonFlux:buildGrid")
-        << "Successfully built a '" << flux_algorithm->parameters() << "' modelling to populate the grid.";
-    std::ofstream output_file(grid_path_, std::ios::out | std::ios::binary);
-    GridHeader header(params_);
-    header.magic_number = header.goodMagic();
-    cepgen::version::tag.copy(header.cepgen_version, 10);
-    output_file.write(reinterpret_cast<char*>(&header), sizeof(GridHeader));
-    GridValue value;
-    for (const auto& w : steer<Limits>("wRange").generate(steer<int>("numPoints"), steer<bool>("logW"))) {
-      value.w = w;
-      value.flux = flux_algorithm->flux(w);
-      output_file.write(reinterpret_cast<char*>(&value), sizeof(GridValue));
-      CG_DEBUG("GridTwoPartonFlux") << "Adding a flux value f(" << value.w << ") = " << value.flux << ".";
+    cepgen::utils::Timer tmr;
+    const auto sqrt_s_values = steer<std::vector<double> >("sqrtSValues"),
+               q2max_values = steer<std::vector<double> >("q2maxValues");
+    for (const auto& axis : {sqrt_s_values, q2max_values})
+      for (size_t i = 0; i < axis.size(); ++i)
+        if (axis.at(i) <= 0. || (i > 0 && axis.at(i) <= axis.at(i - 1)))
+          throw CG_FATAL("GridTwoPartonFlux:buildGrid")
+              << "Multi-dimensional grid axes must be positive and strictly increasing, got " << axis << ".";
+    const auto scan = !sqrt_s_values.empty() || !q2max_values.empty();
+    std::vector<std::vector<GridValue> > slices;
+    const auto base_w_range = steer<Limits>("wRange");
+    auto w_range = base_w_range;
+    for (size_t i = 0; i < std::max<size_t>(sqrt_s_values.size(), 1); ++i)
+      for (size_t j = 0; j < std::max<size_t>(q2max_values.size(), 1); ++j) {
+        auto slice_modelling = modelling;
+        if (!sqrt_s_values.empty()) {  // beam energies are scaled to the tabulated centre-of-mass energy
+          auto beam1 = modelling.get<ParametersList>("beam1"), beam2 = modelling.get<ParametersList>("beam2");
+          const auto energy1 = beam1.get<double>("energy"), energy2 = beam2.get<double>("energy");
+          if (energy1 <= 0. || energy2 <= 0.)
+            throw CG_FATAL("GridTwoPartonFlux:buildGrid")
+                << "Energy scans require a modelling steering both beams energies, got " << energy1 << " and "
+                << energy2 << ".";
+          const auto scale = sqrt_s_values.at(i) / (2. * std::sqrt(energy1 * energy2));
+          slice_modelling.set("beam1", beam1.set("energy", energy1 * scale))
+              .set("beam2", beam2.set("energy", energy2 * scale));
+          // all slices span the same w/sqrt(s) range, down to the lowest one tabulated for the highest energy
+          w_range.min() = base_w_range.min() * sqrt_s_values.at(i) / sqrt_s_values.back();
+          w_range.max() = sqrt_s_values.at(i);
+        }
+        if (!q2max_values.empty())
+          for (const auto& beam : {"beam1"s, "beam2"s}) {
+            auto beam_parameters = slice_modelling.get<ParametersList>(beam);
+            const auto q2_min =
+                beam_parameters.has<Limits>("q2Range") ? beam_parameters.get<Limits>("q2Range").min() : 0.;
+            slice_modelling.set(beam, beam_parameters.set("q2Range", Limits{q2_min, q2max_values.at(j)}));
+          }
+        CG_DEBUG("GridTwoPartonFlux:buildGrid") << "Building grid slice for modelling " << slice_modelling << ".";
+        slices.emplace_back(buildNodes(slice_modelling, w_range));
+      }
+    // grid is written aside and atomically renamed, as other jobs may have the previous version memory-mapped
+    const auto temp_path = grid_path_ + ".tmp" + std::to_string(getpid());
+    size_t num_nodes = 0;
+    {
+      std::ofstream output_file(temp_path, std::ios::out | std::ios::binary);
+      GridHeader header(params_);
+      header.magic_number = scan ? GridHeader::scanMagic() : GridHeader::goodMagic();
+      if (scan)
+        header.clearScannedFields();
+      cepgen::version::tag.copy(header.cepgen_version, 10);
+      output_file.write(reinterpret_cast<char*>(&header), sizeof(GridHeader));
+      if (scan) {  // axes sizes, axes values, and number of nodes per slice
+        std::vector<uint64_t> sizes{sqrt_s_values.size(), q2max_values.size()};
+        for (const auto& slice : slices)
+          sizes.emplace_back(slice.size());
+        output_file.write(reinterpret_cast<const char*>(sizes.data()), 2 * sizeof(uint64_t));
+        for (const auto& axis : {sqrt_s_values, q2max_values})
+          output_file.write(reinterpret_cast<const char*>(axis.data()), axis.size() * sizeof(double));
+        output_file.write(reinterpret_cast<const char*>(sizes.data() + 2), slices.size() * sizeof(uint64_t));
+      }
+      for (const auto& slice : slices) {
+        output_file.write(reinterpret_cast<const char*>(slice.data()), slice.size() * sizeof(GridValue));
+        num_nodes += slice.size();
+      }
+      output_file.close();
+      if (!output_file) {
+        std::remove(temp_path.c_str());
+        throw CG_FATAL("GridTwoPartonFlux:buildGrid") << "Failed to write grid file \"" << temp_path << "\"!";
+      }
+    }
+    if (std::rename(temp_path.c_str(), grid_path_.c_str()) != 0) {
+      const auto error = errno;
+      std::remove(temp_path.c_str());
+      throw CG_FATAL("GridTwoPartonFlux:buildGrid")
+          << "Failed to move grid into \"" << grid_path_ << "\": " << std::strerror(error) << ".";
+    }
+    CG_INFO("GridTwoPartonFlux:buildGrid") << "Two-parton flux grid with " << slices.size() << " slice(s) and "
+                                           << num_nodes << " nodes built in " << tmr.elapsed()
+                                           << " s and stored in \"" << grid_path_ << "\".";
+  }
+  /// Evaluate a modelling on the nodes of a one-dimensional grid in w
+  inline std::vector<GridValue> buildNodes(const ParametersList& modelling, const Limits& w_range) const {
+    const auto num_workers = static_cast<size_t>(std::max(steer<int>("numWorkers"), 1));
+    const auto worker_processes = num_workers > 1 && modelling.name() == "python";
+    std::vector<std::unique_ptr<epa::TwoPartonFlux> > flux_algorithms;  // one modelling per worker thread
+    for (size_t i = 0; i < (worker_processes ? 1 : num_workers); ++i)
+      flux_algorithms.emplace_back(TwoPartonFluxFactory::get().build(modelling));
+    CG_DEBUG("GridTwoPartonFlux:buildNodes")
+        << "Successfully built " << flux_algorithms.size() << " '" << flux_algorithms.front()->parameters()
+        << "' modelling(s) to populate the grid with " << num_workers << " "
+        << (worker_processes ? "process" : "thread") << "(es).";
+    const auto evaluate = [&](const std::vector<double>& w, std::vector<double>& fluxes) {
+      if (worker_processes)
+        evaluateInProcesses(*flux_algorithms.front(), num_workers, w, fluxes);
+      else
+        evaluateInThreads(flux_algorithms, w, fluxes);
+    };
+    const auto log_w = steer<bool>("logW");
+    std::vector<GridValue> nodes;
+    {  // initial nodes, regularly spaced
+      const auto w = w_range.generate(steer<int>("numPoints"), log_w);
+      if (w.size() < 2)
+        throw CG_FATAL("GridTwoPartonFlux:buildNodes") << "At least two grid points are required.";
+      std::vector<double> fluxes;
+      evaluate(w, fluxes);
+      for (size_t i = 0; i < w.size(); ++i)
+        if (std::isfinite(fluxes[i]))  // not kept as a node, as it would spoil the interpolation around
+          nodes.emplace_back(GridValue{w[i], fluxes[i]});
+      if (nodes.size() < 2)
+        throw CG_FATAL("GridTwoPartonFlux:buildNodes")
+            << "Modelling yielded less than two finite flux values over the " << w.size() << " initial grid nodes.";
+      if (nodes.size() < w.size())
+        CG_WARNING("GridTwoPartonFlux:buildNodes")
+            << w.size() - nodes.size() << " initial grid node(s) yielded a non-finite flux, and were discarded.";
+    }
+    if (const auto tolerance = steer<double>("tolerance"); tolerance > 0.)
+      refineGrid(evaluate, nodes, tolerance, log_w);
+    return nodes;
+  }
+  /// Bisect the intervals between nodes until the interpolated flux at their midpoints matches the modelling
+  /// \note Intervals are only bisected further if their midpoint fails both the relative and absolute tolerances,
+  ///   while all evaluated midpoints are kept as nodes. Intervals narrower than the minimal relative width, or whose
+  ///   midpoint flux is not finite, are left as they are.
+  inline void refineGrid(const std::function<void(const std::vector<double>&, std::vector<double>&)>& evaluate,
+                         std::vector<GridValue>& nodes,
+                         double tolerance,
+                         bool log_w) const {
+    const auto interpolation = steerAs<int, Interpolation>("interpolation");
+    const auto max_points = static_cast<size_t>(steer<int>("maxPoints"));
+    const auto min_relative_width = steer<double>("minRelativeWidth");
+    auto absolute_tolerance = steer<double>("absoluteTolerance");
+    if (absolute_tolerance <= 0.) {
+      double max_flux = 0.;
+      for (const auto& node : nodes)  // all finite
+        max_flux = std::max(max_flux, std::fabs(node.flux));
+      absolute_tolerance = tolerance * max_flux;
     }
+    const auto midpoint_of = [&log_w](const GridValue& low, const GridValue& high) {
+      return log_w ? std::sqrt(low.w * high.w) : 0.5 * (low.w + high.w);
+    };
+    // an interval is bisected while its midpoint differs from its bounds at the required resolution
+    const auto splittable = [&midpoint_of, &min_relative_width](const GridValue& low, const GridValue& high) {
+      const auto w = midpoint_of(low, high);
+      return w > low.w && w < high.w && high.w - low.w > min_relative_width * std::fabs(w);
+    };
+    std::vector<bool> to_refine;  // per-interval status
+    for (size_t i = 0; i + 1 < nodes.size(); ++i)
+      to_refine.emplace_back(splittable(nodes[i], nodes[i + 1]));
+    size_t num_unresolved = 0, num_failed = 0;
+    std::vector<double> midpoints, fluxes;
+    for (size_t pass = 1; std::find(to_refine.begin(), to_refine.end(), true) != to_refine.end(); ++pass) {
+      midpoints.clear();
+      for (size_t i = 0; i < to_refine.size(); ++i)
+        if (to_refine[i])
+          midpoints.emplace_back(midpoint_of(nodes[i], nodes[i + 1]));
+      if (nodes.size() + midpoints.size() > max_points) {
+        CG_WARNING("GridTwoPartonFlux:refineGrid")
+            << "Maximum number of nodes (" << max_points << ") reached with " << midpoints.size()
+            << " intervals still above the " << tolerance << " relative tolerance.";
+        return;
+      }
+      evaluate(midpoints, fluxes);  // all midpoints of a pass are evaluated as a single batch
+      std::vector<GridValue> refined_nodes;
+      std::vector<bool> refined_to_refine;
+      refined_nodes.reserve(nodes.size() + midpoints.size());
+      for (size_t i = 0, j = 0; i < to_refine.size(); ++i) {
+        refined_nodes.emplace_back(nodes[i]);
+        if (!to_refine[i]) {
+          refined_to_refine.emplace_back(false);
+          continue;
+        }
+        const GridValue midpoint{midpoints[j], fluxes[j]};
+        ++j;
+        if (!std::isfinite(midpoint.flux)) {  // not kept as a node, as it would spoil the interpolation around
+          ++num_failed;
+          refined_to_refine.emplace_back(false);
+          continue;
+        }
+        const auto deviation =
+            std::fabs(interpolate(nodes.data(), nodes.size(), interpolation, midpoint.w) - midpoint.flux);
+        const bool converged = deviation <= absolute_tolerance || deviation <= tolerance * std::fabs(midpoint.flux);
+        refined_nodes.emplace_back(midpoint);
+        const auto refine = [&](const GridValue& low, const GridValue& high) {
+          const auto split = !converged && splittable(low, high);
+          if (!converged && !split)
+            ++num_unresolved;
+          return split;
+        };
+        refined_to_refine.emplace_back(refine(nodes[i], midpoint));
+        refined_to_refine.emplace_back(refine(midpoint, nodes[i + 1]));
+      }
+      refined_nodes.emplace_back(nodes.back());
+      nodes = std::move(refined_nodes);
+      to_refine = std::move(refined_to_refine);
+      CG_DEBUG("GridTwoPartonFlux:refineGrid")
+          << "Refinement pass " << pass << ": " << nodes.size() << " nodes, "
+          << std::count(to_refine.begin(), to_refine.end(), true) << " intervals above tolerance.";
+    }
+    if (num_unresolved > 0)
+      CG_WARNING("GridTwoPartonFlux:refineGrid")
+          << num_unresolved << " interval(s) reached the minimal relative width (" << min_relative_width
+          << ") while still above the " << tolerance << " relative tolerance.";
+    if (num_failed > 0)
+      CG_WARNING("GridTwoPartonFlux:refineGrid")
+          << num_failed << " interval midpoint(s) yielded a non-finite flux, and were not refined further.";
+  }
+  /// Evaluate a batch of nodes in contiguous chunks, one per worker thread and modelling instance
+  static void evaluateInThreads(const std::vector<std::unique_ptr<epa::TwoPartonFlux> >& flux_algorithms,
+                                const std::vector<double>& w,
+                                std::vector<double>& fluxes) {
+    const auto num_chunks = std::min(flux_algorithms.size(), w.size());
+    if (num_chunks <= 1) {
+      flux_algorithms.front()->fluxes(w, fluxes);
+      return;
+    }
+    fluxes.resize(w.size());
+    std::vector<std::future<void> > workers;
+    for (size_t i = 0; i < num_chunks; ++i)
+      workers.emplace_back(std::async(std::launch::async, [&flux_algorithms, &w, &fluxes, &num_chunks, i] {
+        const auto begin = i * w.size() / num_chunks, end = (i + 1) * w.size() / num_chunks;
+        std::vector<double> chunk_fluxes;
+        flux_algorithms.at(i)->fluxes(std::vector<double>(w.begin() + begin, w.begin() + end), chunk_fluxes);
+        std::copy(chunk_fluxes.begin(), chunk_fluxes.end(), fluxes.begin() + begin);
+      }));
+    for (auto& worker : workers)
+      worker.get();  // rethrow any exception raised by a worker
+  }
+  /// Evaluate a batch of nodes in contiguous chunks, one per forked worker process sending its values through a pipe
+  static void evaluateInProcesses(const epa::TwoPartonFlux& flux_algorithm,
+                                  size_t num_processes,
+                                  const std::vector<double>& w,
+                                  std::vector<double>& fluxes) {
+    const auto num_chunks = std::min(num_processes, w.size());
+    const auto chunk_begin = [&w, &num_chunks](size_t i) { return i * w.size() / num_chunks; };
+    fluxes.resize(w.size());
+    std::vector<std::pair<pid_t, int> > workers;  // process identifier, and reading end of its pipe
+    const auto abort_workers = [&workers] {  // results of the workers already started are discarded
+      for (const auto& worker : workers) {
+        ::close(worker.second);
+        ::kill(worker.first, SIGKILL);
+        ::waitpid(worker.first, nullptr, 0);
+      }
+    };
+    for (size_t i = 0; i < num_chunks; ++i) {
+      int pipe_ends[2];
+      if (::pipe(pipe_ends) != 0) {
+        const auto error = errno;
+        abort_workers();
+        throw CG_FATAL("GridTwoPartonFlux:evaluateInProcesses")
+            << "Failed to create a pipe for worker " << i << ": " << std::strerror(error) << ".";
+      }
+      const auto pid = python::fork();  // interpreter state kept consistent across the fork
+      const auto error = errno;
+      if (pid < 0) {
+        ::close(pipe_ends[0]);
+        ::close(pipe_ends[1]);
+        abort_workers();
+        throw CG_FATAL("GridTwoPartonFlux:evaluateInProcesses")
+            << "Failed to fork worker " << i << ": " << std::strerror(error) << ".";
+      }
+      if (pid == 0) {  // worker process; leave without any cleanup of the parent state
+        ::close(pipe_ends[0]);
+        int status = 0;
+        try {
+          std::vector<double> chunk_fluxes;
+          flux_algorithm.fluxes(std::vector<double>(w.begin() + chunk_begin(i), w.begin() + chunk_begin(i + 1)),
+                                chunk_fluxes);
+          const auto* data = reinterpret_cast<const char*>(chunk_fluxes.data());
+          for (size_t size = chunk_fluxes.size() * sizeof(double), written = 0; written < size;)
+            if (const auto res = ::write(pipe_ends[1], data + written, size - written); res > 0)
+              written += res;
+            else if (res < 0 && errno != EINTR) {
+              status = 1;
+              break;
+            }
+        } catch (...) {
+          status = 1;
+        }
+        ::_exit(status);
+      }
+      ::close(pipe_ends[1]);
+      workers.emplace_back(pid, pipe_ends[0]);
+    }
+    size_t num_failures = 0;
+    for (size_t i = 0; i < workers.size(); ++i) {  // gather the values in the nodes order
+      auto* data = reinterpret_cast<char*>(fluxes.data() + chunk_begin(i));
+      const auto size = (chunk_begin(i + 1) - chunk_begin(i)) * sizeof(double);
+      size_t read = 0;
+      while (read < size)
+        if (const auto res = ::read(workers[i].second, data + read, size - read); res > 0)
+          read += res;
+        else if (res == 0 || errno != EINTR)
+          break;
+      ::close(workers[i].second);
+      int status = 0;
+      ::waitpid(workers[i].first, &status, 0);
+      if (read < size || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        ++num_failures;
+    }
+    if (num_failures > 0)
+      throw CG_FATAL("GridTwoPartonFlux:evaluateInProcesses")
+          << num_failures << " worker process(es) failed to evaluate the modelling.";
   }
   inline void loadGrid() {
-    GridHeader expected_header(params_);
-    expected_header.magic_number = GridHeader::goodMagic();
     cepgen::utils::Timer tmr;
-    {  // file readout part
-      std::ifstream file(grid_path_, std::ios::in);
+    const char* content{nullptr};
+    size_t content_size{0};
+    if (memory_mapped_) {  // nodes are never copied, and only the pages actually accessed are loaded
+      mapped_file_ = std::make_unique<epa::MappedFile>(grid_path_);
+      content = mapped_file_->data();
+      content_size = mapped_file_->size();
+    } else {  // single bulk read of the whole file
+      std::ifstream file(grid_path_, std::ios::in | std::ios::binary | std::ios::ate);
       if (!file.is_open())
         throw CG_FATAL("GridTwoPartonFlux:loadGrid") << "Failed to load grid file \"" << grid_path_ << "\"!";
-      file.read(reinterpret_cast<char*>(&header_), sizeof(GridHeader));
-      if (header_.magic_number != GridHeader::goodMagic() || (check_header_ && header_ != expected_header))
+      content_.resize(file.tellg());
+      file.seekg(0);
+      if (!file.read(content_.data(), content_.size()))
+        throw CG_FATAL("GridTwoPartonFlux:loadGrid") << "Failed to read grid file \"" << grid_path_ << "\"!";
+      content = content_.data();
+      content_size = content_.size();
+    }
+    const auto legacy =
+        content_size >= sizeof(int) && *reinterpret_cast<const int*>(content) == GridHeader::legacyMagic();
+    const auto header_size = legacy ? GridHeader::legacySize() : sizeof(GridHeader);
+    if (content_size < header_size)
+      throw CG_FATAL("GridTwoPartonFlux:loadGrid")
+          << "Grid file \"" << grid_path_ << "\" is too short to hold a header.";
+    std::memcpy(&header_, content, header_size);
+    const auto scan = header_.magic_number == GridHeader::scanMagic();
+    GridHeader expected_header(params_);
+    expected_header.magic_number = scan ? GridHeader::scanMagic() : GridHeader::goodMagic();
+    if (scan)
+      expected_header.clearScannedFields();
+    if (legacy) {  // legacy grids were always linearly interpolated
+      CG_WARNING("GridTwoPartonFlux:loadGrid")
+          << "Grid file \"" << grid_path_ << "\" does not record its interpolation scheme. Assuming linear.";
+      header_.magic_number = GridHeader::goodMagic();
+      header_.interpolation = static_cast<int>(Interpolation::linear);
+    }
+    if (header_.magic_number != expected_header.magic_number || (check_header_ && header_ != expected_header))
+      throw CG_FATAL("GridTwoPartonFlux:loadGrid")
+          << "Invalid grid read from file.\n"
+          << "   Expected header: " << expected_header << ".\n"
+          << "  Retrieved header: " << header_ << ",\n"
+          << "      Magic number: 0x" << std::hex << header_.magic_number << std::dec << ".";
+    if (header_.interpolation < static_cast<int>(Interpolation::linear) ||
+        header_.interpolation > static_cast<int>(Interpolation::steffen))
+      throw CG_FATAL("GridTwoPartonFlux:loadGrid") << "Invalid interpolation scheme: " << header_.interpolation << ".";
+    interpolation_ = static_cast<Interpolation>(header_.interpolation);
+    if (interpolation_ != steerAs<int, Interpolation>("interpolation"))
+      CG_WARNING("GridTwoPartonFlux:loadGrid")
+          << "Grid was built for interpolation scheme " << header_.interpolation << " instead of the steered "
+          << steer<int>("interpolation") << ". Using the former; regenerate the grid to change it.";
+    const char *cursor = content + header_size, *end = content + content_size;
+    const auto consume = [this, &cursor, &end](size_t size) {  // advance through the file content
+      if (static_cast<size_t>(end - cursor) < size)
+        throw CG_FATAL("GridTwoPartonFlux:loadGrid") << "Truncated grid file \"" << grid_path_ << "\".";
+      const auto* block = cursor;
+      cursor += size;
+      return block;
+    };
+    slices_.clear();
+    if (!scan) {  // a single slice spanning the whole file content
+      if ((end - cursor) % sizeof(GridValue) != 0)
+        throw CG_FATAL("GridTwoPartonFlux:loadGrid") << "Truncated grid file \"" << grid_path_ << "\".";
+      slices_.emplace_back(Slice{reinterpret_cast<const GridValue*>(cursor), (end - cursor) / sizeof(GridValue)});
+    } else {  // only the (up to four) slices surrounding the steered beam energies and virtuality cuts are used
+      const auto* axes_sizes = reinterpret_cast<const uint64_t*>(consume(2 * sizeof(uint64_t)));
+      const auto num_sqrt_s = axes_sizes[0], num_q2max = axes_sizes[1],
+                 num_slices = std::max<uint64_t>(num_sqrt_s, 1) * std::max<uint64_t>(num_q2max, 1);
+      const auto* sqrt_s_axis = reinterpret_cast<const double*>(consume(num_sqrt_s * sizeof(double)));
+      const auto* q2max_axis = reinterpret_cast<const double*>(consume(num_q2max * sizeof(double)));
+      const auto* slices_sizes = reinterpret_cast<const uint64_t*>(consume(num_slices * sizeof(uint64_t)));
+      std::vector<const GridValue*> slices_nodes;
+      for (size_t i = 0; i < num_slices; ++i)
+        slices_nodes.emplace_back(reinterpret_cast<const GridValue*>(consume(slices_sizes[i] * sizeof(GridValue))));
+      const auto q2_range = params_.get<Limits>("q2Range1");
+      if (num_q2max > 0 && params_.get<Limits>("q2Range2").max() != q2_range.max())
+        CG_WARNING("GridTwoPartonFlux:loadGrid")
+            << "Virtuality cuts are tabulated for both beams at once. Using the first beam cut, " << q2_range << ".";
+      const auto sqrt_s = 2. * std::sqrt(params_.get<double>("eb1") * params_.get<double>("eb2"));
+      const auto sqrt_s_weights = axisWeights(sqrt_s_axis, num_sqrt_s, sqrt_s, "sqrt(s)");
+      const auto q2max_weights = axisWeights(q2max_axis, num_q2max, q2_range.max(), "q2max");
+      for (const auto& [sqrt_s_index, sqrt_s_weight] : sqrt_s_weights)
+        for (const auto& [q2max_index, q2max_weight] : q2max_weights)
+          if (const auto weight = sqrt_s_weight * q2max_weight; weight > 0.) {
+            const auto index = sqrt_s_index * std::max<uint64_t>(num_q2max, 1) + q2max_index;
+            const auto scale = num_sqrt_s > 0 ? sqrt_s_axis[sqrt_s_index] / sqrt_s : 1.;
+            slices_.emplace_back(Slice{slices_nodes.at(index), slices_sizes[index], weight, scale});
+          }
+    }
+    size_t num_nodes = 0;
+    for (const auto& slice : slices_) {
+      if (slice.num_nodes < 2)
         throw CG_FATAL("GridTwoPartonFlux:loadGrid")
-            << "Invalid grid read from file.\n"
-            << "   Expected header: " << expected_header << ".\n"
-            << "  Retrieved header: " << header_ << ",\n"
-            << "      Magic number: 0x" << std::hex << header_.magic_number << std::dec << ".";
-      GridValue value;
-      while (!file.eof()) {
-        file.read(reinterpret_cast<char*>(&value), sizeof(GridValue));
-        insert({value.w}, {value.flux});
-      }
-      file.close();
-      initialise();  // initialise the grid after filling its nodes
+            << "At least two nodes are required for the interpolation, got " << slice.num_nodes << ".";
+      for (size_t i = 1; i < slice.num_nodes; ++i)
+        if (slice.nodes[i].w <= slice.nodes[i - 1].w)
+          throw CG_FATAL("GridTwoPartonFlux:loadGrid") << "Grid nodes must be strictly increasing in w.";
+      num_nodes += slice.num_nodes;
     }
     CG_INFO("GridTwoPartonFlux:loadGrid") << "Two-parton flux grid evaluator built in " << tmr.elapsed() << " s.\n\t"
-                                          << " w in range " << boundaries().at(0) << ".";
+                                          << " " << num_nodes << " nodes in " << slices_.size() << " slice(s)"
+                                          << (memory_mapped_ ? " (memory-mapped)" : "") << ", interpolation scheme "
+                                          << header_.interpolation << ", w in range " << support() << ".";
+  }
+  /// Bracketing nodes and interpolation weights, linear in the logarithm of the values, along a tabulated axis
+  static std::array<std::pair<size_t, double>, 2> axisWeights(const double* axis,
+                                                              size_t size,
+                                                              double value,
+                                                              const std::string& name) {
+    if (size == 0)  // dimension not tabulated
+      return {{{0, 1.}, {0, 0.}}};
+    if (size == 1) {
+      if (std::fabs(value / axis[0] - 1.) > 1.e-6)
+        throw CG_FATAL("GridTwoPartonFlux:axisWeights")
+            << "Grid is only tabulated for " << name << "=" << axis[0] << ", while " << value << " is requested.";
+      return {{{0, 1.}, {0, 0.}}};
+    }
+    if (!(value >= axis[0] && value <= axis[size - 1]))
+      throw CG_FATAL("GridTwoPartonFlux:axisWeights") << "Requested " << name << "=" << value
+                                                       << " is outside of the tabulated range [" << axis[0] << ", "
+                                                       << axis[size - 1] << "].";
+    const size_t upper = std::clamp<size_t>(std::upper_bound(axis, axis + size, value) - axis, 1, size - 1);
+    const auto fraction = std::log(value / axis[upper - 1]) / std::log(axis[upper] / axis[upper - 1]);
+    return {{{upper - 1, 1. - fraction}, {upper, fraction}}};
+  }
+  /// Interpolation of the flux between the two nodes surrounding w (vanishing outside of the nodes range)
+  static double interpolate(const GridValue* nodes, size_t num_nodes, Interpolation interpolation, double w) {
+    const auto *begin = nodes, *end = nodes + num_nodes;
+    if (w < begin->w || w > (end - 1)->w)
+      return 0.;
+    const auto* upper =
+        std::upper_bound(begin + 1, end - 1, w, [](double w, const GridValue& node) { return w < node.w; });
+    return interpolateInInterval(nodes, num_nodes, interpolation, upper - begin, w);
   }
+  /// Interpolation of the flux at w, lying between the nodes of indices upper - 1 and upper
+  static double interpolateInInterval(
+      const GridValue* nodes, size_t num_nodes, Interpolation interpolation, size_t upper_index, double w) {
+    const auto *upper = nodes + upper_index, *lower = upper - 1;
+    if (interpolation == Interpolation::linear || lower->flux <= 0. || upper->flux <= 0.)  // no logarithm possible
+      return lower->flux + (w - lower->w) / (upper->w - lower->w) * (upper->flux - lower->flux);
+    const auto log_w = std::log(w), log_w_lower = std::log(lower->w), log_w_upper = std::log(upper->w),
+               log_flux_lower = std::log(lower->flux), log_flux_upper = std::log(upper->flux);
+    const auto h = log_w_upper - log_w_lower, t = (log_w - log_w_lower) / h;
+    if (interpolation == Interpolation::logLog)
+      return std::exp(log_flux_lower + t * (log_flux_upper - log_flux_lower));
+    // cubic Hermite polynomial, with node derivatives computed on the fly to keep the nodes untouched
+    const auto index = upper_index - 1;
+    const auto slope_lower = steffenSlope(nodes, num_nodes, index),
+               slope_upper = steffenSlope(nodes, num_nodes, index + 1);
+    const auto t2 = t * t, t3 = t2 * t;
+    return std::exp((2. * t3 - 3. * t2 + 1.) * log_flux_lower + (t3 - 2. * t2 + t) * h * slope_lower +
+                    (3. * t2 - 2. * t3) * log_flux_upper + (t3 - t2) * h * slope_upper);
+  }
+  /// Steffen's monotonicity-preserving derivative of log(flux) with respect to log(w) at a (positive) grid node
+  /// \note Nodes neighbouring non-positive flux values are treated as grid edges
+  static double steffenSlope(const GridValue* nodes, size_t num_nodes, size_t index) {
+    // unsigned indices wrapped below the first node are also out of range
+    const auto positive = [&nodes, &num_nodes](size_t i) { return i < num_nodes && nodes[i].flux > 0.; };
+    const auto step = [&nodes](size_t lower) { return std::log(nodes[lower + 1].w / nodes[lower].w); };
+    const auto secant = [&nodes, &step](size_t lower) {
+      return std::log(nodes[lower + 1].flux / nodes[lower].flux) / step(lower);
+    };
+    if (positive(index - 1) && positive(index + 1)) {  // parabola through the node and its two neighbours
+      const auto h_previous = step(index - 1), h_next = step(index);
+      const auto s_previous = secant(index - 1), s_next = secant(index);
+      const auto parabola_slope = (s_previous * h_next + s_next * h_previous) / (h_previous + h_next);
+      return (std::copysign(1., s_previous) + std::copysign(1., s_next)) *
+             std::min({std::fabs(s_previous), std::fabs(s_next), 0.5 * std::fabs(parabola_slope)});
+    }
+    // edge node: one-sided parabola through the two following (or preceding) nodes, if any
+    const bool forward = positive(index + 1);
+    const auto near = forward ? index : index - 1;
+    if (!positive(forward ? index + 2 : index - 2))
+      return secant(near);
+    const auto far = forward ? index + 1 : index - 2;
+    const auto h_near = step(near), h_far = step(far), s_near = secant(near), s_far = secant(far);
+    const auto parabola_slope = s_near * (1. + h_near / (h_near + h_far)) - s_far * h_near / (h_near + h_far);
+    if (parabola_slope * s_near <= 0.)
+      return 0.;
+    return std::fabs(parabola_slope) > 2. * std::fabs(s_near) ? 2. * s_near : parabola_slope;
+  }
+  /// Frozen layout of the grid headers written before the interpolation scheme was recorded
+  struct LegacyGridHeader {
+    int magic_number;
+    char cepgen_version[10];
+    double eb1, eb2;
+    double q2max1, q2max2;
+    bool fragmenting;
+    int parton1, parton2;
+  };
   struct GridHeader {
     explicit GridHeader(const ParametersList& params)
         : eb1(params.get<double>("eb1")),
@@ -126,20 +679,27 @@ private:
           q2max2(params.get<double>("q2max2")),
           fragmenting(params.get<bool>("fragmenting")),
           parton1(params.get<int>("parton1")),
-          parton2(params.get<int>("parton2")) {}
+          parton2(params.get<int>("parton2")),
+          interpolation(params.get<int>("interpolation")) {}
 
-    static int goodMagic() { return 0xdeadb33f; }
+    static int goodMagic() { return 0xdeadb340; }
+    static int scanMagic() { return 0xdeadb341; }    ///< multi-dimensional grids, over beam energies and cuts
+    static int legacyMagic() { return 0xdeadb33f; }  ///< grids built before the interpolation scheme was recorded
+    /// Size of the headers written before the interpolation scheme was recorded, padding included
+    static constexpr size_t legacySize() { return sizeof(LegacyGridHeader); }
     bool operator==(const GridHeader& oth) const {
       // skip test of cepgen version
       return magic_number == oth.magic_number && eb1 == oth.eb1 && eb2 == oth.eb2 && q2max1 == oth.q2max1 &&
              q2max2 == oth.q2max2 && fragmenting == oth.fragmenting && parton1 == oth.parton1 && parton2 == oth.parton2;
     }
     bool operator!=(const GridHeader& oth) const { return !(*this == oth); }
+    /// Reset the beam energies and virtuality cuts, tabulated in multi-dimensional grids
+    void clearScannedFields() { eb1 = eb2 = q2max1 = q2max2 = 0.; }
     friend std::ostream& operator<<(std::ostream& os, const GridHeader& header) {
       return os << "GridHeader{eb1:" << header.eb1 << ", eb2:" << header.eb2 << ", q2max1:" << header.q2max1
                 << ", q2max2:" << header.q2max2 << ", fragmenting:" << std::boolalpha << header.fragmenting
-                << ", partons PDG ids:" << header.parton1 << ":" << header.parton2 << ", CepGen version:'"
-                << header.cepgen_version << "'}";
+                << ", partons PDG ids:" << header.parton1 << ":" << header.parton2
+                << ", interpolation:" << header.interpolation << ", CepGen version:'" << header.cepgen_version << "'}";
     }
 
     int magic_number;
@@ -148,12 +708,15 @@ private:
     double q2max1, q2max2;
     bool fragmenting;
     int parton1, parton2;
+    int interpolation;  ///< interpolation scheme the nodes were built for (not checked, as nodes remain valid)
   } header_;
-  struct GridValue {
-    double w, flux;
-  };
 
   const std::string grid_path_;
   const bool check_header_;
+  const bool memory_mapped_;
+  std::unique_ptr<epa::MappedFile> mapped_file_;  ///< grid file mapping, if memory-mapped
+  std::vector<char> content_;                     ///< private copy of the grid file content, if not memory-mapped
+  std::vector<Slice> slices_;                     ///< grid slices used for the steered beams, in the file content
+  Interpolation interpolation_{Interpolation::linear};
 };
 REGISTER_TWOPARTON_FLUX("grid", GridTwoPartonFlux);
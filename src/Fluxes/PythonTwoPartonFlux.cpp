@@ -40,14 +40,25 @@ public:
         beam1_(steer<ParametersList>("beam1")),
         beam2_(steer<ParametersList>("beam2")),
         fragmenting_(steer<bool>("fragmenting")),
-        functional_(python::make_functional(steer<std::string>("function"))) {
+        functional_(python::make_functional(steer<std::string>("function"))),
+        batch_functional_(steer<bool>("vectorised")
+                              ? std::make_unique<python::BatchFunctional>(steer<std::string>("function"))
+                              : nullptr) {
     if (!environment_.initialised())
       throw CG_ERROR("PythonTwoPartonFlux") << "Failed to initialise the Python environment.";
     if (!functional_)
       throw CG_ERROR("PythonTwoPartonFlux") << "Failed to retrieve the functional '" << steer<std::string>("function")
                                             << "' from the Python environment.";
-    for (const auto& argument : functional_->arguments())
-      arguments_names_.emplace_back(utils::toLower(argument));
+    arguments_.emplace_back(0.);  // placeholder for w
+    for (size_t i = 1; i < functional_->arguments().size(); ++i)
+      if (const auto argument = utils::toLower(functional_->arguments().at(i)); argument == "eebeam"s)
+        arguments_.emplace_back(beam1_.energy);
+      else if (argument == "pebeam"s)
+        arguments_.emplace_back(beam2_.energy);
+      else if (argument == "eq2max"s)
+        arguments_.emplace_back(beam1_.q2range.max());
+      else if (argument == "pq2max"s)
+        arguments_.emplace_back(beam2_.q2range.max());
   }
 
   static ParametersDescription description() {
@@ -56,23 +67,32 @@ public:
     desc.add("beam1", epa::BeamProperties::description()).setDescription("positive-z beam properties");
     desc.add("beam2", epa::BeamProperties::description()).setDescription("negative-z beam properties");
     desc.add("fragmenting", false).setDescription("is the beam particle fragmenting after parton emission?");
-    desc.add("function", ""s).setDescription("Python two-parton flux path (module.function)");
+    desc.add("function", ""s)
+        .setDescription(
+            "Python two-parton flux path (module.function), with w as first argument, and optionally the beams "
+            "energies (eEbeam, pEbeam) and maximal virtualities (eQ2max, pQ2max)");
+    desc.add("vectorised", false)
+        .setDescription(
+            "is the Python function vectorised, i.e. accepting a list of w values as first argument, and returning "
+            "a sequence of fluxes of the same length? if so, batches of points are evaluated with a single call");
     return desc;
   }
 
   double flux(double w) const override {
-    std::vector<double> arguments{w};
-    if (arguments_names_.size() > 1) {
-      for (size_t i = 1; i < arguments_names_.size(); ++i)
-        if (const auto& argument = arguments_names_.at(i); argument == "eebeam"s)
-          arguments.emplace_back(beam1_.energy);
-        else if (argument == "pebeam"s)
-          arguments.emplace_back(beam2_.energy);
-    }
+    const python::InterpreterLock lock;
+    auto arguments = arguments_;
+    arguments[0] = w;
     const auto res = functional_->operator()(arguments);
     CG_DEBUG("PythonTwoPartonFlux:flux") << "Flux computed for arguments=" << arguments << ": " << res << ".";
     return res;
   }
+  /// Batch evaluation, with a single call to the Python function if vectorised, or one call per point otherwise
+  void fluxes(const std::vector<double>& w, std::vector<double>& values) const override {
+    if (!batch_functional_)
+      return epa::TwoPartonFlux::fluxes(w, values);
+    (*batch_functional_)(w, std::vector<double>(arguments_.begin() + 1, arguments_.end()), values);
+    CG_DEBUG("PythonTwoPartonFlux:fluxes") << "Fluxes computed for " << w.size() << " points in a single call.";
+  }
 
   inline bool fragmenting() const override {
     if (beam1_.flux && beam2_.flux && (beam1_.flux->fragmenting() || beam2_.flux->fragmenting()))
@@ -89,6 +109,7 @@ private:
   const epa::BeamProperties beam2_;
   const bool fragmenting_;
   const std::unique_ptr<python::Functional> functional_;
-  std::vector<std::string> arguments_names_;
+  const std::unique_ptr<python::BatchFunctional> batch_functional_;  ///< vectorised function, if steered
+  std::vector<double> arguments_;  ///< functional arguments, with the beam-dependent ones resolved at construction
 };
 REGISTER_TWOPARTON_FLUX("python", PythonTwoPartonFlux);
@@ -21,11 +21,25 @@
 #include <CepGen/Physics/PDG.h>
 #include <CepGen/Process/Process.h>
 #include <CepGen/Utils/Math.h>
+#include <CepGen/Utils/String.h>
+#include <CepGen/Utils/Timer.h>
 
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <sstream>
+
+#include "CepGenEPA/InverseCDF.h"
+#include "CepGenEPA/SharedModules.h"
 #include "CepGenEPA/TwoPartonFlux.h"
 #include "CepGenEPA/TwoPartonFluxFactory.h"
 #include "CepGenEPA/TwoPartonProcess.h"
 #include "CepGenEPA/TwoPartonProcessFactory.h"
+#include "CepGenEPA/WeightMonitor.h"
+#include "CepGenEPA/WorkerThread.h"
 
 using namespace std::string_literals;
 
@@ -33,13 +47,50 @@ namespace cepgen {
   class EPAProcess : public proc::Process {
   public:
     explicit EPAProcess(const ParametersList& params) : proc::Process(params) {}
+    ~EPAProcess() { mergeCrossSections(); }
 
-    proc::ProcessPtr clone() const { return std::make_unique<EPAProcess>(parameters()); }
+    proc::ProcessPtr clone() const {
+      auto process = std::make_unique<EPAProcess>(parameters());
+      process->cross_sections_ = cross_sections_;  // per-process cross sections are accumulated over all clones
+      return process;
+    }
 
     static ParametersDescription description() {
       auto desc = proc::Process::description();
       desc.setDescription("Generic EPA process");
-      desc.add("logW", true).setDescription("Use a logarithmic mapping of the w distribution?");
+      desc.addAs<int, WMapping>("wMapping", WMapping::logarithmic)
+          .setDescription(
+              "mapping of the w distribution (0: linear, 1: logarithmic, 2: direct sampling from the tabulated "
+              "inverse cumulative distribution of the integrand, yielding unweighted events, 3: power law fitted on "
+              "a pre-scan of the integrand, 4: inverse cumulative distribution of a pre-scan of the integrand, with "
+              "exact weights, 5: Breit-Wigner distribution in w^2 around a resonance); supersedes the deprecated "
+              "\"logW\" boolean, still mapped onto 0 or 1 if steered");
+      desc.add("numCDFPoints", 1000).setDescription("number of log-spaced nodes for the integrand pre-scan");
+      desc.add("densityFloor", 1.e-2)
+          .setDescription(
+              "fraction of the mean pre-scanned density added to it for the adaptive inverse cumulative distribution "
+              "mapping, to keep the full w range reachable");
+      desc.add("resonanceMass", 0.).setDescription("resonance mass for the Breit-Wigner mapping (GeV)");
+      desc.add("resonanceWidth", 0.).setDescription("resonance total width for the Breit-Wigner mapping (GeV)");
+      desc.add("matrixElements", std::vector<ParametersList>{})
+          .setDescription(
+              "list of matrix elements evaluated at each w point with a single flux evaluation, replacing the "
+              "\"matrixElement\" one if non-empty; events are sampled from the sum of all contributions, and "
+              "annotated with each process relative weight (all processes must produce the same central system), "
+              "and the per-process cross sections are summarised at the end of the run");
+      desc.add("alternativeFluxes", std::vector<ParametersList>{})
+          .setDescription(
+              "list of alternative parton fluxes modellings, evaluated at the sampled w point and attached to the "
+              "event as weights relative to the nominal \"partonsFlux\" one, which drives the sampling");
+      desc.add("monitor", ""s)
+          .setDescription(
+              "name of the weight evaluations monitor collecting counters, timers, and the weights distribution, "
+              "shared by all processes with the same name, and summarised at the end of the run (disabled if empty)");
+      desc.add("pipelined", false)
+          .setDescription(
+              "evaluate the matrix elements on a worker thread while the parton fluxes are evaluated, for each point "
+              "and for the pre-scan batches, to overlap their costs when both are expensive (disabled if any matrix "
+              "element is bound to the calling thread, e.g. Python ones)");
       return desc;
     }
 
@@ -53,34 +104,163 @@ namespace cepgen {
                                       {Particle::Role::CentralSystem, central_system_}});
     }
     void prepareKinematics() override {
-      const auto w_range = kinematics().cuts().central.mass_sum.truncate(Limits{1.e-9, (pA() + pB()).mass()});
-      if (steer<bool>("logW"))
-        defineVariable(m_w_central_, Mapping::exponential, w_range.compute(std::log), "w_central");
-      else
-        defineVariable(m_w_central_, Mapping::linear, w_range, "w_central");
-      partons_flux_ = TwoPartonFluxFactory::get().build(ParametersList(steer<ParametersList>("partonsFlux"))
-                                                            .set("eb1", pA().energy())
-                                                            .set("eb2", pB().energy())
-                                                            .set("wRange", w_range)
-                                                            .set("q2Range1", kinematics().cuts().initial.q2.at(0))
-                                                            .set("q2Range2", kinematics().cuts().initial.q2.at(1)));
-      central_process_ = TwoPartonProcessFactory::get().build(steer<ParametersList>("matrixElement"));
-      {  // register the list of particles in the central system
+      mergeCrossSections();  // before the processes are redefined
+      central_processes_.clear();
+      process_names_.clear();
+      auto matrix_elements = steer<std::vector<ParametersList> >("matrixElements");
+      if (matrix_elements.empty())
+        matrix_elements.emplace_back(steer<ParametersList>("matrixElement"));
+      for (const auto& matrix_element : matrix_elements) {
+        const auto& process = central_processes_.emplace_back(
+            epa::SharedModules<epa::TwoPartonProcess>::get(TwoPartonProcessFactory::get(), matrix_element));
+        auto process_name = process->name();
+        if (std::find(process_names_.begin(), process_names_.end(), process_name) != process_names_.end())
+          process_name += ":"s + std::to_string(central_processes_.size() - 1);
+        process_names_.emplace_back(process_name);
+      }
+      process_weights_.assign(central_processes_.size(), 0.);
+      sum_process_weights_.assign(central_processes_.size(), 0.);
+      sum_squared_process_weights_.assign(central_processes_.size(), 0.);
+      {  // register the list of particles in the central system, common to all processes
+        const auto sorted_particles = [](const epa::TwoPartonProcess& process) {
+          auto particles = process.centralParticles();
+          std::sort(particles.begin(), particles.end());
+          return particles;
+        };
+        const auto central_particles = sorted_particles(*central_processes_.front());
+        for (size_t i = 1; i < central_processes_.size(); ++i)
+          if (sorted_particles(*central_processes_.at(i)) != central_particles)
+            throw CG_FATAL("EPAProcess:prepareKinematics")
+                << "All matrix elements must produce the same central system, as the event content is common to "
+                << "all of them. " << process_names_.at(i) << " produces "
+                << central_processes_.at(i)->centralParticles() << " while " << process_names_.front()
+                << " produces " << central_processes_.front()->centralParticles() << ".";
         central_system_.clear();
-        for (const auto& central_particle : central_process_->centralParticles())
+        for (const auto& central_particle : central_processes_.front()->centralParticles())
           central_system_.emplace_back(central_particle);
       }
+      // fluxes are process-independent, and may be shared (or tabulated) for any process, hence built over the full
+      // kinematic range
+      const auto kinematic_w_range = kinematics().cuts().central.mass_sum.truncate(Limits{1.e-9, (pA() + pB()).mass()});
+      const auto build_flux = [this, &kinematic_w_range](const ParametersList& flux_parameters) {
+        auto plist = ParametersList(flux_parameters)
+                         .set("eb1", pA().energy())
+                         .set("eb2", pB().energy())
+                         .set("wRange", kinematic_w_range);
+        for (size_t i = 0; i < 2; ++i)  // virtuality ranges may be varied by the flux modelling
+          if (const auto key = "q2Range"s + std::to_string(i + 1); !flux_parameters.has<Limits>(key))
+            plist.set(key, kinematics().cuts().initial.q2.at(i));
+        return epa::SharedModules<epa::TwoPartonFlux>::get(TwoPartonFluxFactory::get(), plist);
+      };
+      partons_flux_ = build_flux(steer<ParametersList>("partonsFlux"));
+      // no need to sample below the production thresholds, or outside of the flux support
+      const auto w_range = kinematic_w_range.truncate(processesSupport()).truncate(partons_flux_->support());
+      if (!w_range.hasMin() || !w_range.hasMax() || w_range.min() >= w_range.max())
+        throw CG_FATAL("EPAProcess:prepareKinematics")
+            << "Empty w range after intersection with the processes and flux supports: " << w_range << ".";
+      CG_DEBUG("EPAProcess:prepareKinematics") << "w range after intersection with the processes and flux supports: "
+                                               << w_range << ".";
+      alternative_fluxes_.clear();
+      alternative_fluxes_names_.clear();
+      for (const auto& flux_parameters : steer<std::vector<ParametersList> >("alternativeFluxes")) {
+        const auto& flux = alternative_fluxes_.emplace_back(build_flux(flux_parameters));
+        alternative_fluxes_names_.emplace_back("flux:"s + flux->name() + ":"s +
+                                               std::to_string(alternative_fluxes_.size() - 1));
+      }
+      alternative_fluxes_weights_.assign(alternative_fluxes_.size(), 0.);
+      monitor_.reset();
+      if (const auto monitor_name = steer<std::string>("monitor"); !monitor_name.empty()) {
+        const auto monitor = epa::WeightMonitor::get(monitor_name);
+        monitor->book(w_range);
+        monitor_ = std::make_unique<epa::WeightMonitor::Accumulator>(monitor);
+      }
+      w_range_ = w_range;
+      pipelined_ = steer<bool>("pipelined");
+      if (pipelined_)
+        for (size_t i = 0; i < central_processes_.size(); ++i)
+          if (!central_processes_.at(i)->pipelinable()) {
+            CG_WARNING("EPAProcess:prepareKinematics")
+                << "Matrix element " << process_names_.at(i) << " may not be evaluated on a worker thread (e.g. "
+                << "bound to the Python interpreter). Disabling the pipelined evaluation.";
+            pipelined_ = false;
+            break;
+          }
+      if (!pipelined_)
+        worker_.reset();
+      else if (!worker_)
+        worker_ = std::make_unique<epa::WorkerThread>();
+      inverse_cdf_.reset();
+      mapping_ = steerAs<int, WMapping>("wMapping");
+      if (params_.has<bool>("logW")) {  // deprecated steering, superseded by the w mapping enumeration
+        mapping_ = params_.get<bool>("logW") ? WMapping::logarithmic : WMapping::linear;
+        CG_WARNING("EPAProcess:prepareKinematics")
+            << "The 'logW' parameter is deprecated, and overrides the w mapping. Use 'wMapping="
+            << static_cast<int>(mapping_) << "' instead.";
+      }
+      switch (mapping_) {
+        case WMapping::linear:
+          defineVariable(m_w_central_, Mapping::linear, w_range, "w_central");
+          break;
+        case WMapping::logarithmic:
+          defineVariable(m_w_central_, Mapping::exponential, w_range.compute(std::log), "w_central");
+          break;
+        case WMapping::inverseCDF:
+        case WMapping::adaptiveCDF: {
+          std::vector<double> log_w;
+          auto density = scanIntegrand(log_w);
+          if (mapping_ == WMapping::adaptiveCDF) {  // weights are exact, hence the full range must remain reachable
+            const auto floor =
+                steer<double>("densityFloor") * std::accumulate(density.begin(), density.end(), 0.) / density.size();
+            std::transform(
+                density.begin(), density.end(), density.begin(), [&floor](double value) { return value + floor; });
+          }
+          inverse_cdf_ = std::make_unique<epa::InverseCDF>(log_w, density);
+          defineVariable(m_w_quantile_, Mapping::linear, Limits{0., 1.}, "w_quantile");
+        } break;
+        case WMapping::powerLaw:
+          fitPowerLaw();
+          defineVariable(m_w_quantile_, Mapping::linear, Limits{0., 1.}, "w_quantile");
+          break;
+        case WMapping::breitWigner: {
+          resonance_mass_ = steer<double>("resonanceMass");
+          resonance_width_ = steer<double>("resonanceWidth");
+          if (resonance_mass_ <= 0. || resonance_width_ <= 0.)
+            throw CG_FATAL("EPAProcess:prepareKinematics")
+                << "Breit-Wigner mapping requires a positive resonance mass and width, got " << resonance_mass_
+                << " and " << resonance_width_ << ".";
+          // angle variable along which the Breit-Wigner distribution in w^2 is flat
+          const auto angle = [this](double w) {
+            return std::atan((w * w - resonance_mass_ * resonance_mass_) / (resonance_mass_ * resonance_width_));
+          };
+          breit_wigner_range_ = Limits{angle(w_range.min()), angle(w_range.max())};
+          defineVariable(m_w_quantile_, Mapping::linear, Limits{0., 1.}, "w_quantile");
+        } break;
+        default:
+          throw CG_FATAL("EPAProcess:prepareKinematics")
+              << "Invalid w mapping: " << steer<int>("wMapping") << ".";
+      }
     }
     double computeWeight() override {
-      const auto central_weight = central_process_->matrixElement(m_w_central_);
-      if (!utils::positive(central_weight))
-        return 0.;
-      const auto fluxes_weight = partons_flux_->flux({m_w_central_});
-      if (!utils::positive(fluxes_weight))
-        return 0.;
-      return central_weight * fluxes_weight;
+      epa::WeightMonitor::Record record;
+      const auto weight = evaluateWeight(record);
+      if (central_processes_.size() > 1)
+        accumulateCrossSections(weight);
+      if (monitor_) {
+        record.w = m_w_central_;
+        record.weight = weight;
+        monitor_->add(record);
+      }
+      return weight;
     }
     void fillKinematics() override {
+      if (central_processes_.size() > 1) {
+        const auto total_weight = std::accumulate(process_weights_.begin(), process_weights_.end(), 0.);
+        for (size_t i = 0; i < central_processes_.size(); ++i)
+          event().metadata["weight:"s + process_names_.at(i)] =
+              total_weight > 0. ? process_weights_.at(i) / total_weight : 0.;
+      }
+      for (size_t i = 0; i < alternative_fluxes_.size(); ++i)
+        event().metadata["weight:"s + alternative_fluxes_names_.at(i)] = alternative_fluxes_weights_.at(i);
       /*pA() = Momentum(sp4vec_.vec[1].data());
       pB() = Momentum(sp4vec_.vec[0].data());
       pX() = Momentum(sp4vec_.vec[3].data());
@@ -90,11 +270,309 @@ namespace cepgen {
     }
 
   private:
-    std::unique_ptr<epa::TwoPartonFlux> partons_flux_;
-    std::unique_ptr<epa::TwoPartonProcess> central_process_;
+    /// Per-process weights sums over the evaluations of a process and all its clones, summarised once all are released
+    /// \note Cross sections are estimated as plain averages over the sampled points, hence match the integrated one
+    ///   for a uniform sampling of the integration variable, as for non-adaptive integrators
+    struct CrossSections {
+      ~CrossSections() {
+        if (num_evaluations == 0)
+          return;
+        std::ostringstream os;
+        os << "Per-process cross sections estimated over " << num_evaluations << " weight evaluations:";
+        const auto total = std::accumulate(sum_weights.begin(), sum_weights.end(), 0.);
+        for (size_t i = 0; i < process_names.size(); ++i) {
+          const auto mean = sum_weights[i] / num_evaluations,
+                     variance = std::max(sum_squared_weights[i] / num_evaluations - mean * mean, 0.);
+          os << "\n  " << process_names[i] << ": " << mean << " +/- " << std::sqrt(variance / num_evaluations)
+             << " pb (" << (total > 0. ? 100. * sum_weights[i] / total : 0.) << "% of the total)";
+        }
+        CG_INFO("EPAProcess") << os.str();
+      }
+      std::mutex mutex;
+      std::vector<std::string> process_names;
+      unsigned long long num_evaluations{0};
+      std::vector<double> sum_weights, sum_squared_weights;
+    };
+
+    enum struct WMapping {
+      linear = 0,
+      logarithmic = 1,
+      inverseCDF = 2,
+      powerLaw = 3,
+      adaptiveCDF = 4,
+      breitWigner = 5
+    };
+
+    /// Compute the weight for the current phase space point, with the time spent in its components if monitored
+    double evaluateWeight(epa::WeightMonitor::Record& record) {
+      using Status = epa::WeightMonitor::Record::Status;
+      std::optional<utils::Timer> timer;  // only started if monitored
+      if (monitor_)
+        timer.emplace();
+      const auto lap = [&timer](double& time) {  // accumulate the time elapsed since the last lap
+        if (timer) {
+          time += timer->elapsed();
+          timer->reset();
+        }
+      };
+      double jacobian = 1.;  // from the mapped variable to w, if not already accounted for by the integrator
+      switch (mapping_) {
+        case WMapping::inverseCDF: {  // w is sampled from the integrand itself, all events share the same weight
+          m_w_central_ = std::exp((*inverse_cdf_)(m_w_quantile_));
+          if (central_processes_.size() > 1) {  // relative weights only require the matrix elements
+            matrixElement(m_w_central_);
+            lap(record.matrix_element_time);
+          }
+          if (!alternative_fluxes_.empty()) {
+            alternativeFluxes(m_w_central_, partons_flux_->flux(m_w_central_));
+            lap(record.flux_time);
+          }
+          return inverse_cdf_->integral();
+        }
+        case WMapping::powerLaw:
+          m_w_central_ = powerLaw(m_w_quantile_, jacobian);
+          break;
+        case WMapping::breitWigner:
+          m_w_central_ = breitWigner(m_w_quantile_, jacobian);
+          break;
+        case WMapping::adaptiveCDF: {
+          const auto log_w = (*inverse_cdf_)(m_w_quantile_);
+          m_w_central_ = std::exp(log_w);
+          jacobian = m_w_central_ * inverse_cdf_->integral() / inverse_cdf_->density(log_w);
+        } break;
+        default:
+          break;
+      }
+      if (pipelined_)
+        return pipelinedWeight(record) * jacobian;
+      const auto central_weight = matrixElement(m_w_central_);
+      lap(record.matrix_element_time);
+      if (!utils::positive(central_weight)) {
+        record.status = Status::matrixElementZero;
+        return 0.;
+      }
+      const auto fluxes_weight = partons_flux_->flux({m_w_central_});
+      lap(record.flux_time);
+      if (!utils::positive(fluxes_weight)) {
+        record.status = Status::fluxZero;
+        return 0.;
+      }
+      alternativeFluxes(m_w_central_, fluxes_weight);
+      lap(record.flux_time);
+      return central_weight * fluxes_weight * jacobian;
+    }
+    /// Compute the weight at the current w point, evaluating the matrix elements on the persistent worker thread while
+    /// the fluxes are evaluated on the calling one (possibly holding a Python interpreter)
+    double pipelinedWeight(epa::WeightMonitor::Record& record) {
+      using Status = epa::WeightMonitor::Record::Status;
+      const bool monitored = monitor_ != nullptr;
+      double central_weight = 0., fluxes_weight = 0.;
+      worker_->start([this, &record, &central_weight, monitored] {
+        std::optional<utils::Timer> timer;
+        if (monitored)
+          timer.emplace();
+        central_weight = matrixElement(m_w_central_);
+        if (timer)
+          record.matrix_element_time += timer->elapsed();
+      });
+      try {
+        std::optional<utils::Timer> timer;
+        if (monitored)
+          timer.emplace();
+        fluxes_weight = partons_flux_->flux(m_w_central_);
+        alternativeFluxes(m_w_central_, fluxes_weight);
+        if (timer)
+          record.flux_time += timer->elapsed();
+      } catch (...) {
+        worker_->wait();  // the matrix elements task refers to this frame
+        throw;
+      }
+      worker_->wait();
+      if (!utils::positive(central_weight))
+        record.status = Status::matrixElementZero;
+      else if (!utils::positive(fluxes_weight))
+        record.status = Status::fluxZero;
+      else
+        return central_weight * fluxes_weight;
+      return 0.;
+    }
+    /// Union of the central processes supports in w (unbounded on one side if any of them is)
+    Limits processesSupport() const {
+      auto support = central_processes_.front()->support();
+      for (const auto& process : central_processes_) {
+        const auto process_support = process->support();
+        support.min() = support.hasMin() && process_support.hasMin() ? std::min(support.min(), process_support.min())
+                                                                     : Limits::INVALID;
+        support.max() = support.hasMax() && process_support.hasMax() ? std::max(support.max(), process_support.max())
+                                                                     : Limits::INVALID;
+      }
+      return support;
+    }
+    /// Sum of all (non-negative) matrix elements at a given w, individual contributions being kept for the event
+    double matrixElement(double w) {
+      for (size_t i = 0; i < central_processes_.size(); ++i)
+        process_weights_[i] = std::max(central_processes_[i]->matrixElement(w), 0.);
+      return std::accumulate(process_weights_.begin(), process_weights_.end(), 0.);
+    }
+    /// Evaluate all alternative fluxes at a given w, relative to the nominal flux value
+    void alternativeFluxes(double w, double nominal_flux) {
+      for (size_t i = 0; i < alternative_fluxes_.size(); ++i)
+        alternative_fluxes_weights_[i] =
+            utils::positive(nominal_flux) ? alternative_fluxes_[i]->flux(w) / nominal_flux : 0.;
+    }
+    /// Account for the per-process contributions to a weight, including the Jacobian of the w mapping if the latter
+    /// is handled by the integrator
+    void accumulateCrossSections(double weight) {
+      ++num_evaluations_;
+      const auto total_weight = std::accumulate(process_weights_.begin(), process_weights_.end(), 0.);
+      if (!utils::positive(weight) || !utils::positive(total_weight))
+        return;
+      if (mapping_ == WMapping::linear)
+        weight *= w_range_.range();
+      else if (mapping_ == WMapping::logarithmic)
+        weight *= m_w_central_ * std::log(w_range_.max() / w_range_.min());
+      for (size_t i = 0; i < process_weights_.size(); ++i) {
+        const auto process_weight = weight * process_weights_[i] / total_weight;
+        sum_process_weights_[i] += process_weight;
+        sum_squared_process_weights_[i] += process_weight * process_weight;
+      }
+    }
+    /// Add the per-process weights sums of this instance to the ones shared with its clones, and reset them
+    void mergeCrossSections() {
+      if (num_evaluations_ == 0)
+        return;
+      std::lock_guard<std::mutex> lock(cross_sections_->mutex);
+      if (cross_sections_->process_names != process_names_) {  // first merge, or processes changed in between
+        cross_sections_->process_names = process_names_;
+        cross_sections_->num_evaluations = 0;
+        cross_sections_->sum_weights.assign(process_names_.size(), 0.);
+        cross_sections_->sum_squared_weights.assign(process_names_.size(), 0.);
+      }
+      cross_sections_->num_evaluations += num_evaluations_;
+      for (size_t i = 0; i < process_names_.size(); ++i) {
+        cross_sections_->sum_weights[i] += sum_process_weights_[i];
+        cross_sections_->sum_squared_weights[i] += sum_squared_process_weights_[i];
+      }
+      num_evaluations_ = 0;
+      std::fill(sum_process_weights_.begin(), sum_process_weights_.end(), 0.);
+      std::fill(sum_squared_process_weights_.begin(), sum_squared_process_weights_.end(), 0.);
+    }
+    /// Pre-scan the integrand over log-spaced nodes in w, as a density in log(w)
+    std::vector<double> scanIntegrand(std::vector<double>& log_w) const {
+      log_w = w_range_.compute(std::log).generate(steer<int>("numCDFPoints"));
+      std::vector<double> w(log_w.size()), fluxes, density(log_w.size(), 0.);
+      std::transform(log_w.begin(), log_w.end(), w.begin(), [](double lw) { return std::exp(lw); });
+      const auto integral = [&log_w](const std::vector<double>& values) {
+        double integral = 0.;
+        for (size_t i = 1; i < log_w.size(); ++i)
+          integral += 0.5 * (values[i - 1] + values[i]) * (log_w[i] - log_w[i - 1]);
+        return integral;
+      };
+      // all nodes are evaluated as single batches, concurrently to the fluxes batch if pipelined
+      auto matrix_elements_batches = std::async(pipelined_ ? std::launch::async : std::launch::deferred, [this, &w] {
+        std::vector<std::vector<double> > matrix_elements(central_processes_.size());
+        for (size_t i = 0; i < central_processes_.size(); ++i)
+          central_processes_[i]->matrixElements(w, matrix_elements[i]);
+        return matrix_elements;
+      });
+      partons_flux_->fluxes(w, fluxes);
+      const auto matrix_elements = matrix_elements_batches.get();
+      std::vector<double> process_cross_sections;
+      for (const auto& process_matrix_elements : matrix_elements) {
+        std::vector<double> process_density(w.size());
+        for (size_t i = 0; i < w.size(); ++i) {
+          process_density[i] = w[i] * std::max(fluxes[i], 0.) * std::max(process_matrix_elements[i], 0.);
+          density[i] += process_density[i];
+        }
+        process_cross_sections.emplace_back(integral(process_density));
+      }
+      CG_INFO("EPAProcess:scanIntegrand") << "Integrand pre-scanned over " << log_w.size() << " nodes for w in "
+                                          << w_range_ << ". Total cross section: " << integral(density) << " pb.";
+      if (central_processes_.size() > 1)
+        for (size_t i = 0; i < central_processes_.size(); ++i)
+          CG_INFO("EPAProcess:scanIntegrand")
+              << "Cross section for " << process_names_.at(i) << ": " << process_cross_sections.at(i) << " pb.";
+      return density;
+    }
+    /// Fit the power law index of the integrand density in log(w) on a pre-scan
+    void fitPowerLaw() {
+      std::vector<double> log_w;
+      const auto density = scanIntegrand(log_w);
+      double sum_x = 0., sum_y = 0., sum_xx = 0., sum_xy = 0., num_points = 0.;
+      for (size_t i = 0; i < log_w.size(); ++i) {
+        if (!utils::positive(density[i]))  // below threshold
+          continue;
+        const auto log_density = std::log(density[i]);
+        sum_x += log_w[i];
+        sum_y += log_density;
+        sum_xx += log_w[i] * log_w[i];
+        sum_xy += log_w[i] * log_density;
+        ++num_points;
+      }
+      power_law_index_ = 0.;
+      if (const auto denominator = num_points * sum_xx - sum_x * sum_x; num_points >= 2 && denominator > 0.)
+        power_law_index_ = (num_points * sum_xy - sum_x * sum_y) / denominator;
+      else
+        CG_WARNING("EPAProcess:fitPowerLaw") << "Not enough non-vanishing integrand values to fit a power law. "
+                                             << "Falling back to a logarithmic mapping.";
+      CG_INFO("EPAProcess:fitPowerLaw") << "Integrand fitted as a power law, d(sigma)/dw ~ w^(" << power_law_index_ - 1.
+                                        << ").";
+    }
+    /// Map a uniform variable onto w following the fitted power law, and compute the Jacobian of the transformation
+    double powerLaw(double u, double& jacobian) const {
+      const auto w_min = w_range_.min(), w_max = w_range_.max();
+      if (std::fabs(power_law_index_) < 1.e-6) {  // logarithmic limit
+        const auto w = w_min * std::pow(w_max / w_min, u);
+        jacobian = w * std::log(w_max / w_min);
+        return w;
+      }
+      const auto pow_min = std::pow(w_min, power_law_index_), pow_max = std::pow(w_max, power_law_index_);
+      const auto w = std::pow(pow_min + u * (pow_max - pow_min), 1. / power_law_index_);
+      jacobian = (pow_max - pow_min) / power_law_index_ * std::pow(w, 1. - power_law_index_);
+      return w;
+    }
+    /// Map a uniform variable onto w following a Breit-Wigner distribution in w^2, and compute its Jacobian
+    double breitWigner(double u, double& jacobian) const {
+      const auto mass_width = resonance_mass_ * resonance_width_;
+      const auto w2 = resonance_mass_ * resonance_mass_ + mass_width * std::tan(breit_wigner_range_.x(u));
+      const auto w = std::sqrt(w2);
+      // dw/du = dw/d(w^2) * d(w^2)/d(angle) * d(angle)/du
+      jacobian = 0.5 / w * (std::pow(w2 - resonance_mass_ * resonance_mass_, 2) + mass_width * mass_width) /
+                 mass_width * breit_wigner_range_.range();
+      return w;
+    }
+
+    // fluxes and matrix elements are immutable, and shared by all clones steering identical parameters
+    std::shared_ptr<const epa::TwoPartonFlux> partons_flux_;
+    std::vector<std::shared_ptr<const epa::TwoPartonFlux> > alternative_fluxes_;
+    std::vector<std::string> alternative_fluxes_names_;  ///< event metadata keys for the alternative fluxes
+    std::vector<double> alternative_fluxes_weights_;     ///< alternative-to-nominal flux ratios at the last w point
+    std::vector<std::shared_ptr<const epa::TwoPartonProcess> > central_processes_;
+    std::vector<std::string> process_names_;  ///< unique process names, used as event metadata keys
+    std::vector<double> process_weights_;     ///< per-process matrix elements at the last w point
+
+    // per-process cross sections, accumulated locally and merged into the ones shared with all clones
+    std::shared_ptr<CrossSections> cross_sections_{std::make_shared<CrossSections>()};
+    unsigned long long num_evaluations_{0};            ///< weight evaluations not yet merged
+    std::vector<double> sum_process_weights_;          ///< per-process weights sums not yet merged
+    std::vector<double> sum_squared_process_weights_;  ///< per-process squared weights sums not yet merged
 
     spdgids_t central_system_;
-    double m_w_central_{0.};  ///< central, two-parton invariant mass
+    Limits w_range_;                                ///< sampled two-parton invariant mass range
+    WMapping mapping_{WMapping::logarithmic};       ///< two-parton invariant mass mapping
+    double power_law_index_{0.};                    ///< fitted integrand density index in log(w), for power law mapping
+    std::unique_ptr<epa::InverseCDF> inverse_cdf_;  ///< pre-scanned integrand distribution, for inverse CDF mappings
+    bool pipelined_{false};                         ///< evaluate matrix elements and fluxes concurrently?
+    std::unique_ptr<epa::WorkerThread> worker_;     ///< matrix elements evaluation thread, if pipelined
+
+    std::unique_ptr<epa::WeightMonitor::Accumulator> monitor_;  ///< local weight evaluations collector, if monitored
+
+    double resonance_mass_{0.};   ///< resonance mass, for the Breit-Wigner mapping
+    double resonance_width_{0.};  ///< resonance total width, for the Breit-Wigner mapping
+    Limits breit_wigner_range_;   ///< Breit-Wigner angle variable range
+
+    double m_w_central_{0.};   ///< central, two-parton invariant mass
+    double m_w_quantile_{0.};  ///< uniform variable mapped onto w, for the mappings not handled by the integrator
   };
 }  // namespace cepgen
 REGISTER_PROCESS("epa", EPAProcess);
@@ -58,6 +58,7 @@ public:
                std::log((1. + beta) / (1. - beta)) -
            2 + beta2;
   }
+  Limits support() const override { return Limits{std::sqrt(min_w2_), Limits::INVALID}; }
 
 private:
   const std::unique_ptr<Coupling> alpha_em_;
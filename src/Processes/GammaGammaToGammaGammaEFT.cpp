@@ -21,55 +21,128 @@
 #include <CepGen/Modules/IntegratorFactory.h>
 #include <CepGen/Physics/Constants.h>
 #include <CepGen/Physics/PDG.h>
+#include <CepGen/Utils/Filesystem.h>
+#include <CepGen/Utils/GridHandler.h>
+#include <CepGen/Utils/Timer.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <string>
+
+#include "CepGenEPA/AmplitudeTables.h"
 #include "CepGenEPA/HelicityAmplitudes.h"
+#include "CepGenEPA/IntegratorPool.h"
 #include "CepGenEPA/MatrixElements.h"
+#include "CepGenEPA/TQuadrature.h"
 #include "CepGenEPA/TwoPartonProcess.h"
 #include "CepGenEPA/TwoPartonProcessFactory.h"
 
 using namespace cepgen;
+using namespace std::string_literals;
 
 namespace eft_aaaa {
-  // Computes the  squared matrix element and the SM interference from free zeta_1, zeta_2
-  double sqme(double s, double t, bool exclude_loops_SM, double zeta1, double zeta2) {
-    //NOTE: zeta1/zeta2 expressed in GeV^-4
+  void check_domain(double s, double t) {
     if (s < 0 || t > 0 || t < -s)
       throw CG_FATAL("eft_aaaa:sqme") << "Invalid domain. Valid range is s>=0 and -s<=t<=0.";
+  }
+
+  double sqme(double s, double t, const HelicityAmplitudes& me_sm, double zeta1, double zeta2) {
+    const auto interfere = [](const std::complex<double>& me_ex, const std::complex<double>& me_sm) {
+      return std::real(me_ex) * (std::real(me_ex) + 2 * std::real(me_sm)) +
+             std::imag(me_ex) * (std::imag(me_ex) + 2 * std::imag(me_sm));
+    };
 
+    // factor 8 is needed because of the conventions in Costantini, DeTollis, Pistoni
     double value = 0;
+    value += interfere(8. * Mpppp_eft(zeta1, zeta2, s, t), me_sm.pppp);
+    value += interfere(8. * Mppmm_eft(zeta1, zeta2, s, t), me_sm.ppmm);
+    value += interfere(8. * Mpmmp_eft(zeta1, zeta2, s, t), me_sm.pmmp);
+    value += interfere(8. * Mpmpm_eft(zeta1, zeta2, s, t), me_sm.pmpm);
+    value += interfere(8. * Mpppm_eft(zeta1, zeta2, s, t), me_sm.pppm);
+    return 0.5 * value;
+  }
 
-    {  // Mpppp:
-      // factor 8 is needed because of the conventions in Costantini, DeTollis, Pistoni
-      const auto me_ex = 8. * Mpppp_eft(zeta1, zeta2, s, t);                     // exotic matrix element
-      const auto me_sm = sm_aaaa::me_SM(Mpppp_fermion, s, t, exclude_loops_SM);  //  SM matrix element
-      value += std::real(me_ex) * (std::real(me_ex) + 2 * std::real(me_sm)) +
-               std::imag(me_ex) * (std::imag(me_ex) + 2 * std::imag(me_sm));
-    }
-    {  // Mppmm:
-      const auto me_ex = 8. * Mppmm_eft(zeta1, zeta2, s, t);
-      const auto me_sm = sm_aaaa::me_SM(Mppmm_fermion, s, t, exclude_loops_SM);
-      value += std::real(me_ex) * (std::real(me_ex) + 2 * std::real(me_sm)) +
-               std::imag(me_ex) * (std::imag(me_ex) + 2 * std::imag(me_sm));
-    }
-    {  // Mpmmp:
-      const auto me_ex = 8. * Mpmmp_eft(zeta1, zeta2, s, t);
-      const auto me_sm = sm_aaaa::me_SM(Mpmmp_fermion, s, t, exclude_loops_SM);
-      value += std::real(me_ex) * (std::real(me_ex) + 2 * std::real(me_sm)) +
-               std::imag(me_ex) * (std::imag(me_ex) + 2 * std::imag(me_sm));
-    }
-    {  // Mpmpm:
-      const auto me_ex = 8. * Mpmpm_eft(zeta1, zeta2, s, t);
-      const auto me_sm = sm_aaaa::me_SM(Mpmpm_fermion, s, t, exclude_loops_SM);
-      value += std::real(me_ex) * (std::real(me_ex) + 2 * std::real(me_sm)) +
-               std::imag(me_ex) * (std::imag(me_ex) + 2 * std::imag(me_sm));
-    }
-    {  // Mpppm
-      const auto me_ex = 8. * Mpppm_eft(zeta1, zeta2, s, t);
-      const auto me_sm = sm_aaaa::me_SM(Mpppm_fermion, s, t, exclude_loops_SM);
-      value += std::real(me_ex) * (std::real(me_ex) + 2 * std::real(me_sm)) +
-               std::imag(me_ex) * (std::imag(me_ex) + 2 * std::imag(me_sm));
+  std::array<double, 6> sqmeCoefficients(double s, double t, const HelicityAmplitudes& me_sm) {
+    // EFT amplitudes are linear in the couplings, M_ex = zeta1 * a1 + zeta2 * a2, with real a1 and a2
+    // factor 8 is needed because of the conventions in Costantini, DeTollis, Pistoni
+    const auto amplitudes = [&s, &t](double zeta1, double zeta2) {
+      return std::array<std::complex<double>, 5>{8. * Mpppp_eft(zeta1, zeta2, s, t),
+                                                 8. * Mppmm_eft(zeta1, zeta2, s, t),
+                                                 8. * Mpmmp_eft(zeta1, zeta2, s, t),
+                                                 8. * Mpmpm_eft(zeta1, zeta2, s, t),
+                                                 8. * Mpppm_eft(zeta1, zeta2, s, t)};
+    };
+    const auto a1 = amplitudes(1., 0.), a2 = amplitudes(0., 1.);
+    const std::array<std::complex<double>, 5> sm{me_sm.pppp, me_sm.ppmm, me_sm.pmmp, me_sm.pmpm, me_sm.pppm};
+    std::array<double, 6> coefficients{};  // constant term vanishes, as the SM-only contribution is not included
+    for (size_t i = 0; i < sm.size(); ++i) {
+      coefficients[1] += std::real(a1[i] * std::conj(sm[i]));
+      coefficients[2] += std::real(a2[i] * std::conj(sm[i]));
+      coefficients[3] += 0.5 * std::norm(a1[i]);
+      coefficients[4] += 0.5 * std::norm(a2[i]);
+      coefficients[5] += std::real(a1[i] * std::conj(a2[i]));
     }
-    return 0.5 * value;
+    return coefficients;
+  }
+
+  std::array<double, 6> sqmeCoefficients(double s, double t, bool exclude_loops_SM) {
+    static const auto context = sm_aaaa::LoopContext::standardModel();
+    return sqmeCoefficients(context, s, t, exclude_loops_SM);
+  }
+
+  std::array<double, 6> sqmeCoefficients(const sm_aaaa::LoopContext& context,
+                                         double s,
+                                         double t,
+                                         bool exclude_loops_SM) {
+    check_domain(s, t);
+    return sqmeCoefficients(s, t, sm_aaaa::me_SM_all(context, s, t, exclude_loops_SM));
+  }
+
+  // Computes the  squared matrix element and the SM interference from free zeta_1, zeta_2
+  double sqme(double s, double t, bool exclude_loops_SM, double zeta1, double zeta2) {
+    static const auto context = sm_aaaa::LoopContext::standardModel();
+    return sqme(context, s, t, exclude_loops_SM, zeta1, zeta2);
+  }
+
+  double sqme(
+      const sm_aaaa::LoopContext& context, double s, double t, bool exclude_loops_SM, double zeta1, double zeta2) {
+    //NOTE: zeta1/zeta2 expressed in GeV^-4
+    check_domain(s, t);
+    return sqme(s, t, sm_aaaa::me_SM_all(context, s, t, exclude_loops_SM), zeta1, zeta2);
+  }
+
+  void sqme_batch(const std::vector<double>& s,
+                  const std::vector<double>& t,
+                  std::vector<double>& output,
+                  bool exclude_loops_SM,
+                  double zeta1,
+                  double zeta2) {
+    static const auto context = sm_aaaa::LoopContext::standardModel();
+    sqme_batch(context, s, t, output, exclude_loops_SM, zeta1, zeta2);
+  }
+
+  void sqme_batch(const sm_aaaa::LoopContext& context,
+                  const std::vector<double>& s,
+                  const std::vector<double>& t,
+                  std::vector<double>& output,
+                  bool exclude_loops_SM,
+                  double zeta1,
+                  double zeta2) {
+    for (size_t i = 0; i < std::min(s.size(), t.size()); ++i)
+      check_domain(s.at(i), t.at(i));
+    std::vector<HelicityAmplitudes> me_sm;
+    sm_aaaa::me_SM_all(context, s, t, me_sm, exclude_loops_SM);
+    output.resize(me_sm.size());
+    for (size_t i = 0; i < me_sm.size(); ++i)
+      output[i] = sqme(s[i], t[i], me_sm[i], zeta1, zeta2);
   }
 }  //namespace eft_aaaa
 
@@ -77,35 +150,241 @@ class GammaGammaToGammaGammaEFT : public epa::TwoPartonProcess {
 public:
   explicit GammaGammaToGammaGammaEFT(const ParametersList& params)
       : epa::TwoPartonProcess(params),
-        integrator_(IntegratorFactory::get().build(steer<ParametersList>("integrator"))),
         exclude_loops_(steer<bool>("excludeLoops")),
         zeta1_(steer<double>("zeta1")),
-        zeta2_(steer<double>("zeta2")) {}
+        zeta2_(steer<double>("zeta2")),
+        loops_(sm_aaaa::LoopContext::standardModel(
+            AmplitudeTables::build(steer<ParametersList>("amplitudeTables")))),
+        coefficients_path_(steerPath("coefficientsGrid")) {
+    if (const auto integrator = steer<ParametersList>("integrator"); TQuadrature::requested(integrator))
+      quadrature_ = std::make_unique<TQuadrature>(integrator);
+    else
+      integrators_ = std::make_unique<epa::IntegratorPool>(integrator);
+    if (coefficients_path_.empty())
+      return;
+    if (steer<bool>("generateCoefficients") || !utils::fileExists(coefficients_path_))
+      buildCoefficientsGrid();
+    loadCoefficientsGrid();
+  }
 
   static ParametersDescription description() {
     auto desc = epa::TwoPartonProcess::description();
     desc.setDescription("Two-photon production of photon pair (EFT)");
-    desc.add("integrator", IntegratorFactory::get().describeParameters("gsl"));
+    desc.add("integrator", IntegratorFactory::get().describeParameters("gsl"))
+        .setDescription("t-integration algorithm (\"clenshawCurtis\" for a batched fixed-node quadrature)");
     desc.add("excludeLoops", false);
     desc.add("zeta1", 1.e-12);
     desc.add("zeta2", 1.e-12);
+    desc.add("amplitudeTables", AmplitudeTables::description())
+        .setDescription("interpolation tables for the SM loop amplitudes in the exact region");
+    desc.add("coefficientsGrid", ""s)
+        .setDescription(
+            "path to the tabulated cross section coefficients in (1, zeta1, zeta2, zeta1^2, zeta2^2, zeta1*zeta2) "
+            "(direct integration if empty)");
+    desc.add("generateCoefficients", false).setDescription("(re-)generate the coefficients grid prior to run?");
+    desc.add("wRange", Limits{1.e-3, 1.e3}).setDescription("two-photon mass range of the coefficients grid");
+    desc.add("numPoints", 500).setDescription("number of points to compute for the coefficients grid construction");
+    desc.add("coefficientsTolerance", 1.e-6)
+        .setDescription("relative accuracy targeted for the coefficients grid integration, on fixed-node rules");
+    desc.add("logW", true);
     return desc;
   }
 
   std::string processDescription() const override { return "$\\gamma\\gamma\\rightarrow\\gamma\\gamma$ (EFT)"; }
   double matrixElement(double w) const override {
-    const auto s = w * w;
-    return prefactor_ *
-           integrator_->integrate(
-               [this, &s](double t) { return eft_aaaa::sqme(s, t, exclude_loops_, zeta1_, zeta2_) / s / s; },
-               Limits{-s, 0.});
+    std::vector<double> values;
+    return matrixElement(w, monomials(), values);
+  }
+  void matrixElements(const std::vector<double>& w, std::vector<double>& values) const override {
+    const auto zeta_monomials = monomials();
+    std::vector<double> sqme;  // integrand values buffer shared by all masses
+    values.resize(w.size());
+    std::transform(w.begin(), w.end(), values.begin(), [this, &zeta_monomials, &sqme](double w) {
+      return matrixElement(w, zeta_monomials, sqme);
+    });
   }
 
 private:
+  /// Couplings monomials in the (1, zeta1, zeta2, zeta1^2, zeta2^2, zeta1*zeta2) basis
+  std::array<double, 6> monomials() const {
+    return {1., zeta1_, zeta2_, zeta1_ * zeta1_, zeta2_ * zeta2_, zeta1_ * zeta2_};
+  }
+  double matrixElement(double w, const std::array<double, 6>& monomials, std::vector<double>& values) const {
+    if (tabulated_ && coefficients_grid_.boundaries().at(0).contains(w)) {
+      const auto coefficients = coefficients_grid_.eval({w});
+      return std::inner_product(coefficients.begin(), coefficients.end(), monomials.begin(), 0.);
+    }
+    const auto s = w * w;
+    const sm_aaaa::EnergySlice slice(loops_, s, exclude_loops_);  // s-only quantities shared by all t values
+    const auto sqme = [this, &s, &slice](double t) {
+      eft_aaaa::check_domain(s, t);
+      return eft_aaaa::sqme(s, t, slice.amplitudes(t), zeta1_, zeta2_);
+    };
+    if (quadrature_) {
+      const auto t = quadrature_->nodes(s);
+      values.resize(t.size());
+      std::transform(t.begin(), t.end(), values.begin(), sqme);
+      return prefactor_ * quadrature_->integrate(s, values).value / s / s;
+    }
+    return prefactor_ * integrators_->integrate([&sqme, &s](double t) { return sqme(t) / s / s; }, Limits{-s, 0.});
+  }
+  /// Cross section coefficient functions in (1, zeta1, zeta2, zeta1^2, zeta2^2, zeta1*zeta2) at a given mass, with
+  /// their error estimates, all evaluated at once on the quadrature nodes
+  std::array<TQuadrature::Result, 6> integrateCoefficients(const TQuadrature& quadrature,
+                                                           double s,
+                                                           const sm_aaaa::EnergySlice& slice) const {
+    std::vector<std::array<double, 6> > nodes_coefficients;
+    for (const auto& t : quadrature.nodes(s))
+      nodes_coefficients.emplace_back(eft_aaaa::sqmeCoefficients(s, t, slice.amplitudes(t)));
+    std::array<TQuadrature::Result, 6> coefficients{};
+    std::vector<double> values(nodes_coefficients.size());
+    for (size_t i = 1; i < coefficients.size(); ++i) {
+      std::transform(nodes_coefficients.begin(),
+                     nodes_coefficients.end(),
+                     values.begin(),
+                     [&i](const auto& node_coefficients) { return node_coefficients.at(i); });
+      const auto result = quadrature.integrate(s, values);
+      coefficients[i] = TQuadrature::Result{prefactor_ * result.value / s / s, prefactor_ * result.uncertainty / s / s};
+    }
+    return coefficients;
+  }
+  void buildCoefficientsGrid() const {
+    // grids are written aside and atomically renamed, so that an interrupted or concurrent generation never leaves a
+    // truncated grid behind
+    const auto temp_path = coefficients_path_ + ".tmp" + std::to_string(getpid());
+    std::ofstream output_file(temp_path, std::ios::out | std::ios::binary);
+    if (!output_file.is_open())
+      throw CG_FATAL("GammaGammaToGammaGammaEFT:buildCoefficientsGrid")
+          << "Failed to open coefficients grid file \"" << temp_path << "\"!";
+    const auto header = expectedHeader();
+    output_file.write(reinterpret_cast<const char*>(&header), sizeof(CoefficientsHeader));
+    // an adaptive scalar integrator would need one pass per coefficient, each re-evaluating the SM loops for the
+    // interference terms; all coefficients are rather integrated from the same integrand evaluations, on fixed-node
+    // rules of increasing order until all of them converge
+    std::vector<std::unique_ptr<TQuadrature> > rules;
+    if (!quadrature_)
+      for (int num_intervals = 64; num_intervals <= 4096; num_intervals *= 2)
+        rules.emplace_back(std::make_unique<TQuadrature>(
+            ParametersList().set("numIntervals", num_intervals).set("relativeTolerance", 1.)));
+    const auto tolerance = steer<double>("coefficientsTolerance");
+    const auto converged = [&tolerance](const std::array<TQuadrature::Result, 6>& coefficients) {
+      return std::all_of(coefficients.begin(), coefficients.end(), [&tolerance](const auto& coefficient) {
+        return coefficient.uncertainty <= tolerance * std::fabs(coefficient.value);
+      });
+    };
+    size_t num_unconverged = 0;
+    CoefficientsValue value;
+    for (const auto& w : Limits{header.w_min, header.w_max}.generate(header.num_points, header.log_w != 0)) {
+      const auto s = w * w;
+      const sm_aaaa::EnergySlice slice(loops_, s, exclude_loops_);  // s-only quantities shared by all t values
+      std::array<TQuadrature::Result, 6> coefficients{};
+      if (quadrature_)
+        coefficients = integrateCoefficients(*quadrature_, s, slice);
+      else
+        for (const auto& rule : rules) {
+          coefficients = integrateCoefficients(*rule, s, slice);
+          if (converged(coefficients))
+            break;
+        }
+      if (!converged(coefficients))
+        ++num_unconverged;
+      value.w = w;
+      std::transform(coefficients.begin(),
+                     coefficients.end(),
+                     value.coefficients.begin(),
+                     [](const auto& coefficient) { return coefficient.value; });
+      output_file.write(reinterpret_cast<const char*>(&value), sizeof(CoefficientsValue));
+    }
+    output_file.close();
+    if (!output_file) {
+      std::remove(temp_path.c_str());
+      throw CG_FATAL("GammaGammaToGammaGammaEFT:buildCoefficientsGrid")
+          << "Failed to write coefficients grid file \"" << temp_path << "\"!";
+    }
+    if (std::rename(temp_path.c_str(), coefficients_path_.c_str()) != 0) {
+      const auto error = errno;
+      std::remove(temp_path.c_str());
+      throw CG_FATAL("GammaGammaToGammaGammaEFT:buildCoefficientsGrid")
+          << "Failed to move coefficients grid into \"" << coefficients_path_ << "\": " << std::strerror(error) << ".";
+    }
+    if (num_unconverged > 0)
+      CG_WARNING("GammaGammaToGammaGammaEFT:buildCoefficientsGrid")
+          << "Cross section coefficients did not reach the " << tolerance << " relative tolerance for "
+          << num_unconverged << " mass value(s).";
+  }
+  void loadCoefficientsGrid() {
+    utils::Timer tmr;
+    std::ifstream file(coefficients_path_, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+      throw CG_FATAL("GammaGammaToGammaGammaEFT:loadCoefficientsGrid")
+          << "Failed to load coefficients grid file \"" << coefficients_path_ << "\"!";
+    CoefficientsHeader header{};
+    file.read(reinterpret_cast<char*>(&header), sizeof(CoefficientsHeader));
+    if (const auto expected_header = expectedHeader(); !file || header != expected_header)
+      throw CG_FATAL("GammaGammaToGammaGammaEFT:loadCoefficientsGrid")
+          << "Invalid coefficients grid read from file \"" << coefficients_path_ << "\" (set generateCoefficients to "
+          << "rebuild it with the steered parameters).\n"
+          << "   Expected header: " << expected_header << ".\n"
+          << "  Retrieved header: " << header << ".";
+    CoefficientsValue value;
+    size_t num_values = 0;
+    for (; file.read(reinterpret_cast<char*>(&value), sizeof(CoefficientsValue)); ++num_values)
+      coefficients_grid_.insert({value.w}, value.coefficients);
+    if (num_values != header.num_points || file.gcount() != 0)
+      throw CG_FATAL("GammaGammaToGammaGammaEFT:loadCoefficientsGrid")
+          << "Truncated coefficients grid file \"" << coefficients_path_ << "\": " << num_values
+          << " value(s) read for " << header.num_points << " expected.";
+    coefficients_grid_.initialise();
+    tabulated_ = true;
+    CG_INFO("GammaGammaToGammaGammaEFT:loadCoefficientsGrid")
+        << "Cross section coefficients grid built in " << tmr.elapsed() << " s.\n\t"
+        << " w in range " << coefficients_grid_.boundaries().at(0) << ".";
+  }
+
+  /// Coefficients grid file header, with fixed-width fields and no padding
+  struct CoefficientsHeader {
+    static constexpr uint32_t goodMagic() { return 0x3ff7ab1f; }
+    uint32_t magic_number;
+    uint32_t exclude_loops;  ///< SM loops excluded from the interference terms?
+    uint32_t num_points;     ///< number of tabulated two-photon masses
+    uint32_t log_w;          ///< are the tabulated masses log-spaced?
+    double w_min, w_max;     ///< tabulated two-photon mass range
+    bool operator!=(const CoefficientsHeader& oth) const {
+      return magic_number != oth.magic_number || exclude_loops != oth.exclude_loops || num_points != oth.num_points ||
+             log_w != oth.log_w || w_min != oth.w_min || w_max != oth.w_max;
+    }
+    friend std::ostream& operator<<(std::ostream& os, const CoefficientsHeader& header) {
+      return os << "{magic number: 0x" << std::hex << header.magic_number << std::dec
+                << ", SM loops excluded: " << header.exclude_loops << ", " << header.num_points
+                << (header.log_w ? " log" : " linearly") << "-spaced points in w range [" << header.w_min << ", "
+                << header.w_max << "]}";
+    }
+  };
+  static_assert(sizeof(CoefficientsHeader) == 4 * sizeof(uint32_t) + 2 * sizeof(double), "padded header layout");
+  /// Header of a coefficients grid built with the steered parameters
+  CoefficientsHeader expectedHeader() const {
+    const auto w_range = steer<Limits>("wRange");
+    return CoefficientsHeader{CoefficientsHeader::goodMagic(),
+                              exclude_loops_,
+                              static_cast<uint32_t>(steer<int>("numPoints")),
+                              steer<bool>("logW"),
+                              w_range.min(),
+                              w_range.max()};
+  }
+  struct CoefficientsValue {
+    double w;
+    std::array<double, 6> coefficients;
+  };
+
   static constexpr double prefactor_ = constants::GEVM2_TO_PB / 16. * M_1_PI;
-  const std::unique_ptr<Integrator> integrator_;
   const bool exclude_loops_;
   const double zeta1_;
   const double zeta2_;
+  const sm_aaaa::LoopContext loops_;
+  const std::string coefficients_path_;
+  std::unique_ptr<epa::IntegratorPool> integrators_;  ///< one integrator per thread evaluating this shared process
+  std::unique_ptr<TQuadrature> quadrature_;
+  GridHandler<1, 6> coefficients_grid_{GridType::linear};
+  bool tabulated_{false};
 };
 REGISTER_TWOPARTON_PROCESS("gammagammatogammagamma:eft", GammaGammaToGammaGammaEFT);
@@ -22,47 +22,73 @@
 #include <CepGen/Physics/Constants.h>
 #include <CepGen/Physics/PDG.h>
 
+#include <algorithm>
+
+#include "CepGenEPA/AmplitudeTables.h"
 #include "CepGenEPA/HelicityAmplitudes.h"
+#include "CepGenEPA/IntegratorPool.h"
 #include "CepGenEPA/MatrixElements.h"
+#include "CepGenEPA/TQuadrature.h"
 #include "CepGenEPA/TwoPartonProcess.h"
 #include "CepGenEPA/TwoPartonProcessFactory.h"
 
 using namespace cepgen;
 
 namespace sm_aaaa {
-  double prefac_W = -1.;
-  const std::array<double, 9> SM_weight = {1, 1, 1, 16. / 27., 16. / 27., 16. / 27., 1. / 27., 1. / 27., 1. / 27.};
-  std::array<double, 9> SM_masses;
-  bool initialised = false;
+  LoopContext::LoopContext(const std::vector<Fermion>& fermions,
+                           double vector_mass,
+                           std::shared_ptr<const AmplitudeTables> tables)
+      : vector_scale_(0.25 / std::pow(vector_mass, 2)), tables_(tables) {
+    for (const auto& fermion : fermions)
+      fermion_loops_.emplace_back(FermionLoop{1. / (4 * fermion.mass * fermion.mass), fermion.weight});
+  }
 
-  std::complex<double> me_SM(std::complex<double> (*me)(double, double, int), double s, double t, bool exclude_loops) {
-    if (!initialised) {
-      prefac_W = 0.25 / std::pow(PDG::get().mass(23 /*W*/), 2);
-      SM_masses = {PDG::get().mass(11),
-                   PDG::get().mass(13),
-                   PDG::get().mass(15),
-                   PDG::get().mass(2),
-                   PDG::get().mass(4),
-                   PDG::get().mass(6),
-                   PDG::get().mass(1),
-                   PDG::get().mass(3),
-                   PDG::get().mass(5)};
-      initialised = true;
+  LoopContext LoopContext::standardModel(std::shared_ptr<const AmplitudeTables> tables) {
+    // SM fermion content: (e,mu,tau,u,c,t,d,s,b)
+    // weight equals (number of colors) * (el. charge)^4
+    // SM masses in GeV
+    return LoopContext({{PDG::get().mass(11), 1.},
+                        {PDG::get().mass(13), 1.},
+                        {PDG::get().mass(15), 1.},
+                        {PDG::get().mass(2), 16. / 27.},
+                        {PDG::get().mass(4), 16. / 27.},
+                        {PDG::get().mass(6), 16. / 27.},
+                        {PDG::get().mass(1), 1. / 27.},
+                        {PDG::get().mass(3), 1. / 27.},
+                        {PDG::get().mass(5), 1. / 27.}},
+                       PDG::get().mass(23 /*W*/),
+                       tables);
+  }
+
+  namespace {
+    /// Loop content used whenever none is explicitly provided
+    const LoopContext& defaultContext() {
+      static const auto context = LoopContext::standardModel();  // thread-safe initialisation
+      return context;
+    }
+
+    void checkDomain(double s, double t) {
+      if (s < 0 || t > 0 || t < -s)
+        throw CG_FATAL("sm_aaaa:sqme") << "Invalid domain. Valid range is s>=0 and -s<=t<=0.";
+    }
+
+    double squaredAmplitude(const HelicityAmplitudes& me) {
+      return 0.5 * (4. * std::norm(me.pppm) + std::norm(me.ppmm) + std::norm(me.pppp) + std::norm(me.pmmp) +
+                    std::norm(me.pmpm));
     }
+  }  // namespace
+
+  std::complex<double> me_SM(std::complex<double> (*me)(double, double, int), double s, double t, bool exclude_loops) {
+    const auto& context = defaultContext();
     // This routine computes the complex SM amplitude
     // The first argument can be any of the helicity amplitudes Mpppp,Mppmm,Mpmpm,Mpmmp,Mpppm
     std::complex<double> output;
 
-    // SM fermion content: (e,mu,tau,u,c,t,d,s,b)
-    // SM_weight equals (number of colors) * (el. charge)^4
-    // SM masses in GeV
-    for (size_t i = 0; i < SM_masses.size(); i++) {
-      const auto prefac_f = 1. / (4 * SM_masses.at(i) * SM_masses.at(i));
-      const auto d = me(s * prefac_f, t * prefac_f, exclude_loops);
-      output += SM_weight.at(i) * d;
-    }
+    for (const auto& fermion : context.fermionLoops())
+      output += fermion.weight * me(s * fermion.scale, t * fermion.scale, exclude_loops);
 
     // Add also the W contribution
+    const auto prefac_W = context.vectorScale();
     if (me == Mpppp_fermion)
       output += Mpppp_vector(s * prefac_W, t * prefac_W, exclude_loops);
     else if (me == Mppmm_fermion)
@@ -81,46 +107,158 @@ namespace sm_aaaa {
     return output;
   }
 
+  HelicityAmplitudes me_SM_all(const LoopContext& context, double s, double t, bool exclude_loops) {
+    // same loop content as me_SM, but all helicity amplitudes are computed from a single
+    // evaluation of the loop functions for each particle
+    HelicityAmplitudes output;
+    for (const auto& fermion : context.fermionLoops())
+      output +=
+          fermion.weight * Mall_fermion(s * fermion.scale, t * fermion.scale, exclude_loops, context.tables());
+    output += Mall_vector(
+        s * context.vectorScale(), t * context.vectorScale(), exclude_loops, context.tables());  // W contribution
+    output *= 8 * constants::ALPHA_EM * constants::ALPHA_EM;
+    return output;
+  }
+
+  void me_SM_all(const LoopContext& context,
+                 const std::vector<double>& s,
+                 const std::vector<double>& t,
+                 std::vector<HelicityAmplitudes>& output,
+                 bool exclude_loops) {
+    if (s.size() != t.size())
+      throw CG_FATAL("sm_aaaa:me_SM_all") << "Inconsistent batch sizes: " << s.size() << " != " << t.size() << ".";
+    output.assign(s.size(), HelicityAmplitudes{});
+    for (const auto& fermion : context.fermionLoops())
+      Mall_fermion(s, t, fermion.scale, fermion.weight, exclude_loops, output, context.tables());
+    Mall_vector(s, t, context.vectorScale(), 1., exclude_loops, output, context.tables());  // W contribution
+    for (auto& amplitudes : output)
+      amplitudes *= 8 * constants::ALPHA_EM * constants::ALPHA_EM;
+  }
+
+  EnergySlice::EnergySlice(const LoopContext& context, double s, bool exclude_loops) : s_(s) {
+    const auto add_loop = [this](double scale, double weight, LoopSlice&& slice) {
+      if (!slice.lowEnergy()) {
+        loops_.emplace_back(Loop{scale, weight, std::move(slice)});
+        return;
+      }
+      // amplitudes are polynomials in the reduced variables, (sred, tred, ured) = scale * (s, t, u)
+      const auto coefficients = slice.lowEnergyCoefficients();
+      low_loops_.c += weight * scale * scale * coefficients.c;
+      low_loops_.c_ppmm += weight * scale * scale * coefficients.c_ppmm;
+    };
+    for (const auto& fermion : context.fermionLoops())
+      add_loop(fermion.scale,
+               fermion.weight,
+               LoopSlice(LoopSlice::Particle::fermion, s * fermion.scale, exclude_loops, context.tables()));
+    const auto vector_scale = context.vectorScale();  // W contribution
+    add_loop(vector_scale,
+             1.,
+             LoopSlice(LoopSlice::Particle::vector, s * vector_scale, exclude_loops, context.tables()));
+  }
+
+  HelicityAmplitudes EnergySlice::amplitudes(double t) const {
+    const auto u = -s_ - t;
+    HelicityAmplitudes output{low_loops_.c * s_ * s_,
+                              low_loops_.c * t * t,
+                              low_loops_.c * u * u,
+                              0.,
+                              low_loops_.c_ppmm * (s_ * s_ + t * t + u * u)};
+    for (const auto& loop : loops_)
+      output += loop.weight * loop.slice(t * loop.scale);
+    output *= 8 * constants::ALPHA_EM * constants::ALPHA_EM;
+    return output;
+  }
+
+  double EnergySlice::sqme(double t) const {
+    checkDomain(s_, t);
+    return squaredAmplitude(amplitudes(t));
+  }
+
+  void EnergySlice::sqme(const std::vector<double>& t, std::vector<double>& output) const {
+    output.resize(t.size());
+    std::transform(t.begin(), t.end(), output.begin(), [this](double t) { return sqme(t); });
+  }
+
   // compute the SM squared matrix element, including leptons, quarks and the W boson
-  double sqme(double s, double t, bool exclude_loops) {
-    if (s < 0 || t > 0 || t < -s)
-      throw CG_FATAL("sm_aaaa:sqme") << "Invalid domain. Valid range is s>=0 and -s<=t<=0.";
+  double sqme(double s, double t, bool exclude_loops) { return sqme(defaultContext(), s, t, exclude_loops); }
 
-    return 0.5 * (4. * std::norm(me_SM(Mpppm_fermion, s, t, exclude_loops)) +
-                  std::norm(me_SM(Mppmm_fermion, s, t, exclude_loops)) +
-                  std::norm(me_SM(Mpppp_fermion, s, t, exclude_loops)) +
-                  std::norm(me_SM(Mpmmp_fermion, s, t, exclude_loops)) +
-                  std::norm(me_SM(Mpmpm_fermion, s, t, exclude_loops)));
+  double sqme(const LoopContext& context, double s, double t, bool exclude_loops) {
+    checkDomain(s, t);
+    return squaredAmplitude(me_SM_all(context, s, t, exclude_loops));
   }
 
+  void sqme_batch(const std::vector<double>& s,
+                  const std::vector<double>& t,
+                  std::vector<double>& output,
+                  bool exclude_loops) {
+    sqme_batch(defaultContext(), s, t, output, exclude_loops);
+  }
+
+  void sqme_batch(const LoopContext& context,
+                  const std::vector<double>& s,
+                  const std::vector<double>& t,
+                  std::vector<double>& output,
+                  bool exclude_loops) {
+    for (size_t i = 0; i < std::min(s.size(), t.size()); ++i)
+      checkDomain(s.at(i), t.at(i));
+    std::vector<HelicityAmplitudes> amplitudes;
+    me_SM_all(context, s, t, amplitudes, exclude_loops);
+    output.resize(amplitudes.size());
+    std::transform(amplitudes.begin(), amplitudes.end(), output.begin(), squaredAmplitude);
+  }
 }  //namespace sm_aaaa
 
 class GammaGammaToGammaGammaSM : public epa::TwoPartonProcess {
 public:
   explicit GammaGammaToGammaGammaSM(const ParametersList& params)
       : epa::TwoPartonProcess(params),
-        integrator_(IntegratorFactory::get().build(steer<ParametersList>("integrator"))),
-        exclude_loops_(steer<bool>("excludeLoops")) {}
+        exclude_loops_(steer<bool>("excludeLoops")),
+        loops_(sm_aaaa::LoopContext::standardModel(
+            AmplitudeTables::build(steer<ParametersList>("amplitudeTables")))) {
+    if (const auto integrator = steer<ParametersList>("integrator"); TQuadrature::requested(integrator))
+      quadrature_ = std::make_unique<TQuadrature>(integrator);
+    else
+      integrators_ = std::make_unique<epa::IntegratorPool>(integrator);
+  }
 
   static ParametersDescription description() {
     auto desc = epa::TwoPartonProcess::description();
     desc.setDescription("Two-photon production of photon pair (SM)");
-    desc.add("integrator", IntegratorFactory::get().describeParameters("gsl"));
+    desc.add("integrator", IntegratorFactory::get().describeParameters("gsl"))
+        .setDescription("t-integration algorithm (\"clenshawCurtis\" for a batched fixed-node quadrature)");
     desc.add("excludeLoops", false);
+    desc.add("amplitudeTables", AmplitudeTables::description())
+        .setDescription("interpolation tables for the loop amplitudes in the exact region");
     return desc;
   }
 
   std::string processDescription() const override { return "$\\gamma\\gamma\\rightarrow\\gamma\\gamma$ (SM)"; }
   double matrixElement(double w) const override {
+    std::vector<double> sqme;
+    return matrixElement(w, sqme);
+  }
+  void matrixElements(const std::vector<double>& w, std::vector<double>& values) const override {
+    std::vector<double> sqme;  // integrand values buffer shared by all masses
+    values.resize(w.size());
+    std::transform(w.begin(), w.end(), values.begin(), [this, &sqme](double w) { return matrixElement(w, sqme); });
+  }
+
+private:
+  double matrixElement(double w, std::vector<double>& sqme) const {
     const auto s = w * w;
+    const sm_aaaa::EnergySlice slice(loops_, s, exclude_loops_);  // s-only quantities shared by all t values
+    if (quadrature_) {
+      slice.sqme(quadrature_->nodes(s), sqme);
+      return prefactor_ * quadrature_->integrate(s, sqme).value / s / s;
+    }
     return prefactor_ *
-           integrator_->integrate([this, &s](double t) { return sm_aaaa::sqme(s, t, exclude_loops_) / s / s; },
-                                  Limits{-s, 0.});
+           integrators_->integrate([&slice, &s](double t) { return slice.sqme(t) / s / s; }, Limits{-s, 0.});
   }
 
-private:
   static constexpr double prefactor_ = constants::GEVM2_TO_PB / 16. * M_1_PI;
-  const std::unique_ptr<Integrator> integrator_;
   const bool exclude_loops_;
+  const sm_aaaa::LoopContext loops_;
+  std::unique_ptr<epa::IntegratorPool> integrators_;  ///< one integrator per thread evaluating this shared process
+  std::unique_ptr<TQuadrature> quadrature_;
 };
 REGISTER_TWOPARTON_PROCESS("gammagammatogammagamma:sm", GammaGammaToGammaGammaSM);
@@ -0,0 +1,134 @@
+/*
+ *  CepGen: a central exclusive processes event generator
+ *  Copyright (C) 2026  Laurent Forthomme
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <CepGen/Core/Exception.h>
+#include <CepGen/Integration/Integrator.h>
+#include <CepGen/Modules/IntegratorFactory.h>
+#include <CepGen/Physics/Constants.h>
+
+#include <algorithm>
+#include <optional>
+
+#include "CepGenEPA/AmplitudeTables.h"
+#include "CepGenEPA/HelicityAmplitudes.h"
+#include "CepGenEPA/IntegratorPool.h"
+#include "CepGenEPA/MatrixElements.h"
+#include "CepGenEPA/TQuadrature.h"
+#include "CepGenEPA/TwoPartonProcess.h"
+#include "CepGenEPA/TwoPartonProcessFactory.h"
+
+using namespace cepgen;
+
+/// Light-by-light scattering through the s-, t-, and u-channel exchange of a CP-even spin-0 resonance
+class GammaGammaToGammaGammaSpin0Even : public epa::TwoPartonProcess {
+public:
+  explicit GammaGammaToGammaGammaSpin0Even(const ParametersList& params)
+      : epa::TwoPartonProcess(params),
+        mass_(steer<double>("mass")),
+        f0_(steer<double>("f0")),
+        extra_width_(steer<double>("extraWidth")),
+        form_factor_scale2_(steer<double>("formFactorScale2")),
+        include_sm_(steer<bool>("includeSM")),
+        exclude_loops_(steer<bool>("excludeLoops")),
+        loops_(sm_aaaa::LoopContext::standardModel(
+            AmplitudeTables::build(steer<ParametersList>("amplitudeTables")))) {
+    if (mass_ <= 0. || f0_ <= 0. || extra_width_ < 0.)
+      throw CG_FATAL("GammaGammaToGammaGammaSpin0Even")
+          << "Invalid resonance parameters: mass=" << mass_ << ", f0=" << f0_ << ", extra width=" << extra_width_
+          << ".";
+    if (const auto integrator = steer<ParametersList>("integrator"); TQuadrature::requested(integrator))
+      quadrature_ = std::make_unique<TQuadrature>(integrator);
+    else
+      integrators_ = std::make_unique<epa::IntegratorPool>(integrator);
+    CG_INFO("GammaGammaToGammaGammaSpin0Even")
+        << "Resonance of mass " << mass_ << " GeV and total width "
+        << mass_ * mass_ * mass_ / (4. * M_PI * f0_ * f0_) + extra_width_ << " GeV.";
+  }
+
+  static ParametersDescription description() {
+    auto desc = epa::TwoPartonProcess::description();
+    desc.setDescription("Two-photon production of photon pair (spin-0 even resonance)");
+    desc.add("mass", 750.).setDescription("resonance mass (GeV)");
+    desc.add("f0", 1.e4).setDescription("resonance coupling scale to photons (GeV)");
+    desc.add("extraWidth", 0.).setDescription("resonance width in addition to its diphoton partial width (GeV)");
+    desc.add("formFactorScale2", 0.)
+        .setDescription(
+            "squared scale of the a2 / (a2 + |s|) amplitudes form factor (GeV^2, disabled if non-positive)");
+    desc.add("includeSM", false).setDescription("include the SM amplitudes, and their interference?");
+    desc.add("integrator", IntegratorFactory::get().describeParameters("gsl"))
+        .setDescription("t-integration algorithm (\"clenshawCurtis\" for a batched fixed-node quadrature)");
+    desc.add("excludeLoops", false);
+    desc.add("amplitudeTables", AmplitudeTables::description())
+        .setDescription("interpolation tables for the SM loop amplitudes in the exact region");
+    return desc;
+  }
+
+  std::string processDescription() const override {
+    return "$\\gamma\\gamma\\rightarrow X\\rightarrow\\gamma\\gamma$ (spin-0 even)";
+  }
+  double matrixElement(double w) const override {
+    std::vector<double> values;
+    return matrixElement(w, values);
+  }
+  void matrixElements(const std::vector<double>& w, std::vector<double>& values) const override {
+    std::vector<double> sqme;  // integrand values buffer shared by all masses
+    values.resize(w.size());
+    std::transform(w.begin(), w.end(), values.begin(), [this, &sqme](double w) { return matrixElement(w, sqme); });
+  }
+
+private:
+  double matrixElement(double w, std::vector<double>& values) const {
+    const auto s = w * w;
+    std::optional<sm_aaaa::EnergySlice> slice;  // s-only SM quantities shared by all t values
+    if (include_sm_)
+      slice.emplace(loops_, s, exclude_loops_);
+    const auto sqme = [this, &s, &slice](double t) {
+      if (s < 0 || t > 0 || t < -s)
+        throw CG_FATAL("GammaGammaToGammaGammaSpin0Even:sqme") << "Invalid domain. Valid range is s>=0 and -s<=t<=0.";
+      // factor 8 is needed because of the conventions in Costantini, DeTollis, Pistoni
+      HelicityAmplitudes me{8. * Mpppp_spin0even(s, t, mass_, f0_, extra_width_, form_factor_scale2_),
+                            8. * Mpmmp_spin0even(s, t, mass_, f0_, extra_width_, form_factor_scale2_),
+                            8. * Mpmpm_spin0even(s, t, mass_, f0_, extra_width_, form_factor_scale2_),
+                            8. * Mpppm_spin0even(s, t, mass_, f0_, extra_width_, form_factor_scale2_),
+                            8. * Mppmm_spin0even(s, t, mass_, f0_, extra_width_, form_factor_scale2_)};
+      if (slice)
+        me += slice->amplitudes(t);
+      return 0.5 * (4. * std::norm(me.pppm) + std::norm(me.ppmm) + std::norm(me.pppp) + std::norm(me.pmmp) +
+                    std::norm(me.pmpm));
+    };
+    if (quadrature_) {
+      const auto t = quadrature_->nodes(s);
+      values.resize(t.size());
+      std::transform(t.begin(), t.end(), values.begin(), sqme);
+      return prefactor_ * quadrature_->integrate(s, values).value / s / s;
+    }
+    return prefactor_ * integrators_->integrate([&sqme, &s](double t) { return sqme(t) / s / s; }, Limits{-s, 0.});
+  }
+
+  static constexpr double prefactor_ = constants::GEVM2_TO_PB / 16. * M_1_PI;
+  const double mass_;
+  const double f0_;
+  const double extra_width_;
+  const double form_factor_scale2_;
+  const bool include_sm_;
+  const bool exclude_loops_;
+  const sm_aaaa::LoopContext loops_;
+  std::unique_ptr<epa::IntegratorPool> integrators_;  ///< one integrator per thread evaluating this shared process
+  std::unique_ptr<TQuadrature> quadrature_;
+};
+REGISTER_TWOPARTON_PROCESS("gammagammatogammagamma:spin0even", GammaGammaToGammaGammaSpin0Even);
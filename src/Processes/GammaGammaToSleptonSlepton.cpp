@@ -49,6 +49,7 @@ public:
     return 2. * constants::GEVM2_TO_PB * M_PI * alpha2 / wgg / wgg * beta *
            (2. - beta2 - (1. - beta2 * beta2) / (2. * beta) * std::log((1. + beta) / (1. - beta)));
   }
+  Limits support() const override { return Limits{2. * msl_, Limits::INVALID}; }
 
 private:
   const double msl_;
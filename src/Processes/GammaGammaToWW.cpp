@@ -53,6 +53,7 @@ public:
     }
     return 0.;
   }
+  Limits support() const override { return Limits{2. * mw_, Limits::INVALID}; }
 
 private:
   static constexpr double prefactor_ = 4. * M_PI * constants::GEVM2_TO_PB;
@@ -45,6 +45,7 @@ public:
     }
     return 0.;
   }
+  Limits support() const override { return Limits{2. * mz_, Limits::INVALID}; }
 
 private:
   const double mz_;
@@ -31,20 +31,38 @@ public:
   explicit PythonTwoPartonProcess(const ParametersList& params)
       : epa::TwoPartonProcess(params),
         environment_(steer<ParametersList>("environment")),
-        central_function_(python::make_functional(steer<std::string>("function"))) {}
+        central_function_(python::make_functional(steer<std::string>("function"))),
+        batch_function_(steer<bool>("vectorised")
+                            ? std::make_unique<python::BatchFunctional>(steer<std::string>("function"))
+                            : nullptr) {}
 
   static ParametersDescription description() {
     auto desc = epa::TwoPartonProcess::description();
     desc.setDescription("Python two-parton process");
     desc.add("function", ""s).setDescription("Python functional used for matrix element computation");
+    desc.add("vectorised", false)
+        .setDescription(
+            "is the Python function vectorised, i.e. accepting a list of w values, and returning a sequence of matrix "
+            "elements of the same length? if so, batches of points are evaluated with a single call");
     return desc;
   }
 
   std::string processDescription() const override { return "Python process"; }  //FIXME
-  double matrixElement(double w) const override { return central_function_->operator()({w}); }
+  bool pipelinable() const override { return false; }  // the interpreter lock may be held by the calling thread
+  double matrixElement(double w) const override {
+    const python::InterpreterLock lock;
+    return central_function_->operator()({w});
+  }
+  /// Batch evaluation, with a single call to the Python function if vectorised, or one call per point otherwise
+  void matrixElements(const std::vector<double>& w, std::vector<double>& values) const override {
+    if (!batch_function_)
+      return epa::TwoPartonProcess::matrixElements(w, values);
+    (*batch_function_)(w, {}, values);
+  }
 
 private:
   python::Environment environment_;
   std::unique_ptr<python::Functional> central_function_;
+  std::unique_ptr<python::BatchFunctional> batch_function_;  ///< vectorised function, if steered
 };
 REGISTER_TWOPARTON_PROCESS("python", PythonTwoPartonProcess);
@@ -0,0 +1,291 @@
+#include <CepGen/Core/Exception.h>
+#include <CepGen/Core/ParametersList.h>
+#include <CepGen/Utils/Filesystem.h>
+#include <CepGen/Utils/Limits.h>
+#include <CepGen/Utils/Timer.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "CepGenEPA/AmplitudeTables.h"
+
+using namespace std::string_literals;
+
+namespace {
+  /// Maximal deviation of an approximated set of amplitudes, relative to the largest exact amplitude
+  double relativeDeviation(const HelicityAmplitudes& approx, const HelicityAmplitudes& exact) {
+    const auto scale = std::max({std::abs(exact.pppp),
+                                 std::abs(exact.pmmp),
+                                 std::abs(exact.pmpm),
+                                 std::abs(exact.pppm),
+                                 std::abs(exact.ppmm),
+                                 std::numeric_limits<double>::min()});
+    return std::max({std::abs(approx.pppp - exact.pppp),
+                     std::abs(approx.pmmp - exact.pmmp),
+                     std::abs(approx.pmpm - exact.pmpm),
+                     std::abs(approx.pppm - exact.pppm),
+                     std::abs(approx.ppmm - exact.ppmm)}) /
+           scale;
+  }
+
+  /// Cubic Lagrange interpolation weights for nodes at (-1, 0, 1, 2), evaluated at x in [0, 1]
+  std::array<double, 4> lagrangeWeights(double x) {
+    return {-x * (x - 1.) * (x - 2.) / 6.,
+            (x + 1.) * (x - 1.) * (x - 2.) / 2.,
+            -(x + 1.) * x * (x - 2.) / 2.,
+            (x + 1.) * x * (x - 1.) / 6.};
+  }
+
+  /// Bicubic interpolation in the (is, ic) cell of a row-major nodes array
+  /// \param[in] accumulate add the weighted node amplitudes to the interpolated value
+  template <typename F>
+  void interpolate(
+      const AmplitudeTables::Node* nodes, size_t num_c, size_t is, size_t ic, double fs, double fc, F&& accumulate) {
+    const auto ws = lagrangeWeights(fs), wc = lagrangeWeights(fc);
+    for (size_t i = 0; i < 4; ++i) {
+      const auto* row = nodes + (is + i - 1) * num_c + ic - 1;
+      for (size_t j = 0; j < 4; ++j)
+        accumulate(ws[i] * wc[j], row[j]);
+    }
+  }
+
+  HelicityAmplitudes interpolateFermion(
+      const AmplitudeTables::Node* nodes, size_t num_c, size_t is, size_t ic, double fs, double fc) {
+    std::array<std::complex<double>, 5> values{};
+    interpolate(nodes, num_c, is, ic, fs, fc, [&values](double weight, const AmplitudeTables::Node& node) {
+      for (size_t k = 0; k < values.size(); ++k)
+        values[k] += weight * node.fermion[k];
+    });
+    return HelicityAmplitudes{values[0], values[1], values[2], values[3], values[4]};
+  }
+
+  HelicityAmplitudes interpolateVector(
+      const AmplitudeTables::Node* nodes, size_t num_c, size_t is, size_t ic, double fs, double fc) {
+    std::array<std::complex<double>, 5> values{};
+    interpolate(nodes, num_c, is, ic, fs, fc, [&values](double weight, const AmplitudeTables::Node& node) {
+      for (size_t k = 0; k < 3; ++k)
+        values[k] += weight * node.vector[k];
+      for (size_t k = 3; k < 5; ++k)  // M+++- and M++-- are proportional to their fermion loop counterpart
+        values[k] += -1.5 * weight * node.fermion[k];
+    });
+    return HelicityAmplitudes{values[0], values[1], values[2], values[3], values[4]};
+  }
+}  // namespace
+
+AmplitudeTables::AmplitudeTables(const std::string& path) {
+  const auto fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw CG_FATAL("AmplitudeTables") << "Failed to open amplitude tables file \"" << path << "\"!";
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(sizeof(Header))) {
+    close(fd);
+    throw CG_FATAL("AmplitudeTables") << "Invalid amplitude tables file \"" << path << "\".";
+  }
+  size_ = file_stat.st_size;
+  data_ = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);  // mapping remains valid after the descriptor is closed
+  if (data_ == MAP_FAILED)
+    throw CG_FATAL("AmplitudeTables") << "Failed to memory-map amplitude tables file \"" << path << "\".";
+
+  header_ = static_cast<const Header*>(data_);
+  const auto& bins = header_->binning;
+  const auto num_nodes = bins.num_log_s * bins.num_cos_theta;
+  if (header_->magic_number != Header::goodMagic() || header_->node_size != sizeof(Node) || bins.num_log_s < 2 ||
+      bins.num_cos_theta < 2 || size_ != sizeof(Header) + num_nodes * sizeof(Node) +
+                                            (bins.num_log_s - 1) * (bins.num_cos_theta - 1) * sizeof(uint8_t)) {
+    const auto magic_number = header_->magic_number;  // mapping is released before reporting
+    munmap(data_, size_);
+    data_ = nullptr;
+    header_ = nullptr;
+    throw CG_FATAL("AmplitudeTables") << "Invalid amplitude tables read from file \"" << path << "\".\n"
+                                      << "      Magic number: 0x" << std::hex << magic_number << std::dec
+                                      << ", file size: " << size_ << ".";
+  }
+  nodes_ = reinterpret_cast<const Node*>(static_cast<const char*>(data_) + sizeof(Header));
+  cells_ = reinterpret_cast<const uint8_t*>(nodes_ + num_nodes);
+  log_s_min_ = std::log(bins.s_min);
+  inv_log_s_step_ = (bins.num_log_s - 1) / (std::log(bins.s_max) - log_s_min_);
+  inv_cos_theta_step_ = (bins.num_cos_theta - 1) / (2. * bins.cos_theta_max);
+}
+
+AmplitudeTables::~AmplitudeTables() {
+  if (data_)
+    munmap(data_, size_);
+}
+
+void AmplitudeTables::generate(const std::string& path, const Binning& binning) {
+  if (binning.num_log_s < 2 || binning.num_cos_theta < 2 || binning.s_min <= 0. || binning.s_max <= binning.s_min ||
+      binning.cos_theta_max <= 0. || binning.cos_theta_max >= 1. || binning.tolerance <= 0.)
+    throw CG_FATAL("AmplitudeTables:generate") << "Invalid binning for amplitude tables.";
+  cepgen::utils::Timer tmr;
+  const auto num_s = binning.num_log_s, num_c = binning.num_cos_theta;
+  const auto log_s_min = std::log(binning.s_min),
+             log_s_step = (std::log(binning.s_max) - log_s_min) / (num_s - 1),
+             cos_theta_step = 2. * binning.cos_theta_max / (num_c - 1);
+  const auto tolerance = 0.5 * binning.tolerance;  // safety margin for the deviations between probed points
+  // exact amplitudes at fractional node coordinates
+  const auto exact = [&](double is, double ic, HelicityAmplitudes& fermion, HelicityAmplitudes& vector) {
+    const auto sred = std::exp(log_s_min + is * log_s_step), cos_theta = -binning.cos_theta_max + ic * cos_theta_step;
+    Mall_exact(sred, -0.5 * sred * (1. - cos_theta), fermion, vector);
+  };
+
+  std::vector<Node> nodes(num_s * num_c);
+  for (size_t is = 0; is < num_s; ++is)
+    for (size_t ic = 0; ic < num_c; ++ic) {
+      HelicityAmplitudes fermion, vector;
+      exact(is, ic, fermion, vector);
+      nodes[is * num_c + ic] = Node{{fermion.pppp, fermion.pmmp, fermion.pmpm, fermion.pppm, fermion.ppmm},
+                                    {vector.pppp, vector.pmmp, vector.pmpm}};
+    }
+
+  // validity of the interpolation at a given point of the (is, ic) cell, evaluated from its 4x4 surrounding nodes
+  const auto validity = [&](size_t is, size_t ic, double fs, double fc) {
+    HelicityAmplitudes fermion, vector;
+    exact(is + fs, ic + fc, fermion, vector);
+    uint8_t output = invalid;
+    if (relativeDeviation(interpolateFermion(nodes.data(), num_c, is, ic, fs, fc), fermion) < tolerance)
+      output |= fermion_valid;
+    if (relativeDeviation(interpolateVector(nodes.data(), num_c, is, ic, fs, fc), vector) < tolerance)
+      output |= vector_valid;
+    return output;
+  };
+  // cells on the tables boundaries lack the neighbouring nodes for a cubic interpolation, and stay invalid
+  const auto interpolable = [&num_s, &num_c](size_t is, size_t ic) {
+    return is > 0 && is + 2 < num_s && ic > 0 && ic + 2 < num_c;
+  };
+  // validity of the cells edges midpoints, shared among neighbouring cells
+  std::vector<uint8_t> s_edges(num_s * num_c, invalid), c_edges(num_s * num_c, invalid);
+  for (size_t is = 0; is < num_s; ++is)
+    for (size_t ic = 0; ic < num_c; ++ic) {
+      if (interpolable(is, ic)) {  // lower edges of the (is, ic) cell
+        s_edges[is * num_c + ic] = validity(is, ic, 0.5, 0.);
+        c_edges[is * num_c + ic] = validity(is, ic, 0., 0.5);
+      } else {  // upper edges of the last cells in each direction
+        if (ic > 0 && interpolable(is, ic - 1))
+          s_edges[is * num_c + ic] = validity(is, ic - 1, 0.5, 1.);
+        if (is > 0 && interpolable(is - 1, ic))
+          c_edges[is * num_c + ic] = validity(is - 1, ic, 1., 0.5);
+      }
+    }
+  // a cell is validated if its centre and all its edges midpoints are within tolerance
+  std::vector<uint8_t> cells((num_s - 1) * (num_c - 1), invalid);
+  for (size_t is = 0; is + 1 < num_s; ++is)
+    for (size_t ic = 0; ic + 1 < num_c; ++ic)
+      if (interpolable(is, ic))
+        cells[is * (num_c - 1) + ic] = validity(is, ic, 0.5, 0.5) & s_edges[is * num_c + ic] &
+                                       s_edges[is * num_c + ic + 1] & c_edges[is * num_c + ic] &
+                                       c_edges[(is + 1) * num_c + ic];
+
+  // tables are written aside and atomically renamed, as other jobs may have the previous version mapped
+  const auto temp_path = path + ".tmp" + std::to_string(getpid());
+  {
+    std::ofstream output_file(temp_path, std::ios::out | std::ios::binary);
+    if (!output_file.is_open())
+      throw CG_FATAL("AmplitudeTables:generate") << "Failed to open amplitude tables file \"" << temp_path << "\"!";
+    const Header header{Header::goodMagic(), sizeof(Node), binning};
+    output_file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    output_file.write(reinterpret_cast<const char*>(nodes.data()), nodes.size() * sizeof(Node));
+    output_file.write(reinterpret_cast<const char*>(cells.data()), cells.size() * sizeof(uint8_t));
+    output_file.close();
+    if (!output_file) {
+      std::remove(temp_path.c_str());
+      throw CG_FATAL("AmplitudeTables:generate") << "Failed to write amplitude tables file \"" << temp_path << "\"!";
+    }
+  }
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    const auto error = errno;
+    std::remove(temp_path.c_str());
+    throw CG_FATAL("AmplitudeTables:generate") << "Failed to move amplitude tables into \"" << path
+                                               << "\": " << std::strerror(error) << ".";
+  }
+  CG_INFO("AmplitudeTables:generate") << "Amplitude tables with " << num_s << "x" << num_c
+                                      << " nodes generated in " << tmr.elapsed() << " s and stored into \"" << path
+                                      << "\".";
+}
+
+std::shared_ptr<const AmplitudeTables> AmplitudeTables::build(const cepgen::ParametersList& params) {
+  const auto path = params.get<std::string>("path");
+  if (path.empty())
+    return nullptr;
+  if (params.get<bool>("generate") || !cepgen::utils::fileExists(path)) {
+    Binning binning;
+    binning.num_log_s = params.get<int>("numLogS");
+    binning.num_cos_theta = params.get<int>("numCosTheta");
+    const auto s_range = params.get<cepgen::Limits>("sRange");
+    binning.s_min = s_range.min();
+    binning.s_max = s_range.max();
+    binning.cos_theta_max = params.get<double>("cosThetaMax");
+    binning.tolerance = params.get<double>("tolerance");
+    generate(path, binning);
+  }
+  auto tables = std::make_shared<const AmplitudeTables>(path);
+  CG_INFO("AmplitudeTables:build") << "Amplitude tables loaded from \"" << path << "\". "
+                                   << 100. * tables->validFraction() << "% of the cells are interpolated.";
+  return tables;
+}
+
+cepgen::ParametersDescription AmplitudeTables::description() {
+  const Binning binning;
+  auto desc = cepgen::ParametersDescription();
+  desc.add("path", ""s).setDescription("path to the amplitude tables (exact evaluation if empty)");
+  desc.add("generate", false).setDescription("(re-)generate the tables prior to run?");
+  desc.add("numLogS", static_cast<int>(binning.num_log_s)).setDescription("number of nodes in log(sred)");
+  desc.add("numCosTheta", static_cast<int>(binning.num_cos_theta)).setDescription("number of nodes in cos(theta)");
+  desc.add("sRange", cepgen::Limits{binning.s_min, binning.s_max}).setDescription("range of reduced s tabulated");
+  desc.add("cosThetaMax", binning.cos_theta_max).setDescription("maximal |cos(theta)| tabulated");
+  desc.add("tolerance", binning.tolerance).setDescription("maximal relative interpolation error allowed in a cell");
+  return desc;
+}
+
+std::optional<HelicityAmplitudes> AmplitudeTables::fermion(double sred, double tred) const {
+  size_t is, ic;
+  double fs, fc;
+  if (!locate(sred, tred, fermion_valid, is, ic, fs, fc))
+    return std::nullopt;
+  return interpolateFermion(nodes_, binning().num_cos_theta, is, ic, fs, fc);
+}
+
+std::optional<HelicityAmplitudes> AmplitudeTables::vector(double sred, double tred) const {
+  size_t is, ic;
+  double fs, fc;
+  if (!locate(sred, tred, vector_valid, is, ic, fs, fc))
+    return std::nullopt;
+  return interpolateVector(nodes_, binning().num_cos_theta, is, ic, fs, fc);
+}
+
+double AmplitudeTables::validFraction() const {
+  const auto num_cells = (binning().num_log_s - 1) * (binning().num_cos_theta - 1);
+  return 1. * std::count_if(cells_, cells_ + num_cells, [](uint8_t cell) { return cell != invalid; }) / num_cells;
+}
+
+bool AmplitudeTables::locate(
+    double sred, double tred, uint8_t validity, size_t& is, size_t& ic, double& fs, double& fc) const {
+  if (sred <= 0.)
+    return false;
+  const auto& bins = binning();
+  const auto xs = (std::log(sred) - log_s_min_) * inv_log_s_step_,
+             xc = (1. + 2. * tred / sred + bins.cos_theta_max) * inv_cos_theta_step_;
+  if (!(xs >= 0. && xc >= 0.))  // also rejects NaNs
+    return false;
+  is = static_cast<size_t>(xs);
+  ic = static_cast<size_t>(xc);
+  if (is + 1 >= bins.num_log_s || ic + 1 >= bins.num_cos_theta)
+    return false;
+  if (!(cells_[is * (bins.num_cos_theta - 1) + ic] & validity))  // boundary cells are never validated
+    return false;
+  fs = xs - is;
+  fc = xc - ic;
+  return true;
+}
@@ -1,7 +1,6 @@
-#include <gsl/gsl_sf.h>
-
 #include <cmath>
 
+#include "CepGenEPA/Dilogarithm.h"
 #include "CepGenEPA/Utils.h"
 
 namespace cepgen::epa::utils {
@@ -49,25 +48,15 @@ namespace cepgen::epa::utils {
     if (q > 0 && q < 1) {                       // b(q) is imaginary, arguments of dilogs are complex
       const auto b = std::sqrt(1. / q - 1.);
 
-      auto r = (a + 1) / std::hypot(a, b);
-      const auto theta = -std::atan(b / a);  // r e^itheta = (a+1)/(a+b)
-
-      gsl_sf_result result_re, result_im;
-      gsl_sf_complex_dilog_e(r, theta, &result_re, &result_im);
-
-      auto result = -2 * result_re.val;  // -Re[ Li2( a+1/a+b) + Li2( a+1/a-b)]
-
-      r = (a - 1) / sqrt(a * a + b * b);  // r e^itheta = (a-1)/(a+b)
-
-      gsl_sf_complex_dilog_e(r, theta, &result_re, &result_im);
+      const auto inv_ab = 1. / std::complex<double>(a, b);  // complex conjugate arguments share the same real part
 
-      result += 2 * result_re.val;  // Re[ Li2( a-1/a+b) + Li2( a-1/a-b)]
+      auto result = -2 * std::real(dilog((a + 1) * inv_ab));  // -Re[ Li2( a+1/a+b) + Li2( a+1/a-b)]
+      result += 2 * std::real(dilog((a - 1) * inv_ab));       // Re[ Li2( a-1/a+b) + Li2( a-1/a-b)]
       return result;
     }
     // b(q) real and so are all the arguments of the dilogs
     const auto b = std::sqrt(1. - 1. / q);
-    return gsl_sf_dilog((a - 1) / (a + b)) + gsl_sf_dilog((a - 1) / (a - b)) - gsl_sf_dilog((a + 1) / (a + b)) -
-           gsl_sf_dilog((a + 1) / (a - b));
+    return dilog((a - 1) / (a + b)) + dilog((a - 1) / (a - b)) - dilog((a + 1) / (a + b)) - dilog((a + 1) / (a - b));
   }
 
   std::complex<double> I(double z, double w) {  // allowed regions z,w<=0 || z>=0,-z<=w<=0
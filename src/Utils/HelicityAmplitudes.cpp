@@ -3,8 +3,12 @@
 
 #include <CepGen/Physics/PDG.h>
 
+#include <array>
 #include <cmath>
+#include <optional>
+#include <vector>
 
+#include "CepGenEPA/AmplitudeTables.h"
 #include "CepGenEPA/HelicityAmplitudes.h"
 #include "CepGenEPA/Utils.h"
 
@@ -12,18 +16,29 @@ using namespace std::complex_literals;
 
 enum struct Region { no_limits, low, high, forward, backward };
 
+namespace {
+  constexpr double s_eft = 1.e-3, s_low = 1.e1, s_high = 1.e9, t_low = 1.e-4, u_low = 1.e-3;
+  // EFT limit amplitudes: M++++ = c sred^2, M+--+ = c tred^2, M+-+- = c ured^2, M++-- = c_ppmm (sred^2+tred^2+ured^2)
+  constexpr double eft_fermion = -4. * (4. * (-1. / 36.) + 3. * (7. / 90.)),
+                   eft_fermion_ppmm = -4. * (4. * (-1. / 36.) + (7. / 90.)),
+                   eft_vector = -4. * (4. * (-5. / 32.) + 3. * (27. / 40.));
+}  // namespace
+
 Region limits(double sred, double tred, double ured) {
-  static constexpr double s_low = 1.e1, s_high = 1.e9, t_low = 1.e-4, u_low = 1.e-3;
-  if (sred <= 1.e-3)
-    return Region::low;  // EFT limit
-  if ((sred <= s_low && -tred < t_low * sred) || (sred > s_low && sred <= s_high && -tred < 1.e-3) ||
-      (sred > s_high && -tred < 1.))
-    return Region::forward;  // forward limit
-  if ((sred <= s_low && -ured < t_low * sred) || (sred > s_low && -ured < u_low) || (sred > s_high && -ured < 1.))
-    return Region::backward;  // backward limit
-  if (sred > s_high)
-    return Region::high;     // high energy limit
-  return Region::no_limits;  // no limit
+  // conditions are combined without short-circuiting, so that the classification
+  // of a batch of points can be vectorised by the compiler
+  const bool low = sred <= s_eft;  // EFT limit
+  const bool forward = ((sred <= s_low) & (-tred < t_low * sred)) |
+                       ((sred > s_low) & (sred <= s_high) & (-tred < 1.e-3)) |
+                       ((sred > s_high) & (-tred < 1.));  // forward limit
+  const bool backward = ((sred <= s_low) & (-ured < t_low * sred)) | ((sred > s_low) & (-ured < u_low)) |
+                        ((sred > s_high) & (-ured < 1.));  // backward limit
+  const bool high = sred > s_high;                         // high energy limit
+  return low        ? Region::low
+         : forward  ? Region::forward
+         : backward ? Region::backward
+         : high     ? Region::high
+                    : Region::no_limits;  // no limit
 
   // explanation:
   // for sred>shigh, optimal value to switch from HE limit to forward limit is |tred|=1
@@ -31,325 +46,631 @@ Region limits(double sred, double tred, double ured) {
   // for sred<shigh, only switch from exact result to forward limit at |t| < 0.001 for better accuracy
 }
 
-std::complex<double> Mxxxx_fermion(double x, double y) {
-  // some auxilliary function used in Mpppp, Mpmpm, Mpmmp.
-  std::complex<double> output{1., 0.};
+namespace {
+  using cepgen::epa::utils::B;
+  using cepgen::epa::utils::I;
+  using cepgen::epa::utils::T;
+
+  /// Loop functions shared by all helicity amplitudes at a given (sred, tred, ured) point
+  struct LoopFunctions {
+    explicit LoopFunctions(double sred, double tred, double ured) : LoopFunctions(B(sred), T(sred), sred, tred, ured) {}
+    /// Build from the sred-only loop functions, evaluated once for all tred values
+    explicit LoopFunctions(
+        const std::complex<double>& b_s, const std::complex<double>& t_s, double sred, double tred, double ured)
+        : b_s(b_s),
+          b_t(B(tred)),
+          b_u(B(ured)),
+          t_s(t_s),
+          t_t(T(tred)),
+          t_u(T(ured)),
+          i_st(I(sred, tred)),
+          i_su(I(sred, ured)),
+          i_tu(I(tred, ured)) {}
+
+    const std::complex<double> b_s, b_t, b_u;
+    const std::complex<double> t_s, t_t, t_u;
+    const std::complex<double> i_st, i_su, i_tu;  ///< I(z, w) is symmetric under z <-> w
+  };
+
+  std::complex<double> Mxxxx_fermion(double x,
+                                     double y,
+                                     double z,
+                                     const std::complex<double>& b_y,
+                                     const std::complex<double>& b_z,
+                                     const std::complex<double>& t_y,
+                                     const std::complex<double>& t_z,
+                                     const std::complex<double>& i_xy,
+                                     const std::complex<double>& i_xz,
+                                     const std::complex<double>& i_yz) {
+    std::complex<double> output{1., 0.};
+
+    double temp;
+
+    temp = 2 * (y * y + z * z) / (x * x) - 2 / x;
+    output += temp * (t_y + t_z);
+
+    temp = 1 / (2 * x * y) - 1 / y;
+    output += temp * i_xy;
+
+    temp = 1 / (2 * x * z) - 1 / z;
+    output += temp * i_xz;
+
+    temp = 4 / x + 1 / y + 1 / z + 1 / (2 * z * y) - 2 * (y * y + z * z) / (x * x);
+    output += temp * i_yz;
+
+    temp = 2 * (y - z) / x;
+    output += temp * (b_y - b_z);
+
+    return output;
+  }
 
-  const double z = -x - y;
-  double temp;
+  std::complex<double> Mxxxx_vector(double x,
+                                    double y,
+                                    double z,
+                                    const std::complex<double>& b_y,
+                                    const std::complex<double>& b_z,
+                                    const std::complex<double>& t_y,
+                                    const std::complex<double>& t_z,
+                                    const std::complex<double>& i_xy,
+                                    const std::complex<double>& i_xz,
+                                    const std::complex<double>& i_yz) {
+    std::complex<double> output{-1.5, 0.};
 
-  temp = 2 * (y * y + z * z) / (x * x) - 2 / x;
-  output += temp * (cepgen::epa::utils::T(y) + cepgen::epa::utils::T(z));
+    double temp = -3 * (y - z) / x;
+    output += temp * (b_y - b_z);
 
-  temp = 1 / (2 * x * y) - 1 / y;
-  output += temp * cepgen::epa::utils::I(x, y);
+    temp = -1 / x * (8 * x - 3 - 6 * y * z / x);
+    output += temp * (t_y + t_z);
 
-  temp = 1 / (2 * x * z) - 1 / z;
-  output += temp * cepgen::epa::utils::I(x, z);
+    temp = 1 / x * (8 * x - 6 - 6 * y * z / x) - 4 * (x - 0.25) * (x - 0.75) / (y * z);
+    output += temp * i_yz;
 
-  temp = 4 / x + 1 / y + 1 / z + 1 / (2 * z * y) - 2 * (y * y + z * z) / (x * x);
-  output += temp * cepgen::epa::utils::I(y, z);
+    temp = -4 * (x - 0.25) * (x - 0.75) / (x * y);
+    output += temp * i_xy;
 
-  temp = 2 * (y - z) / x;
-  output += temp * (cepgen::epa::utils::B(y) - cepgen::epa::utils::B(z));
+    temp = -4 * (x - 0.25) * (x - 0.75) / (x * z);
+    output += temp * i_xz;
 
-  return output;
+    return output;
+  }
+}  // namespace
+
+HelicityAmplitudes& HelicityAmplitudes::operator+=(const HelicityAmplitudes& oth) {
+  pppp += oth.pppp;
+  pmmp += oth.pmmp;
+  pmpm += oth.pmpm;
+  pppm += oth.pppm;
+  ppmm += oth.ppmm;
+  return *this;
 }
 
-std::complex<double> Mpppp_fermion(double sred, double tred, int exclude_loops) {
-  // M++++ from Costantini, DeTollis, Pistoni; Nuovo Cim. A2 (1971) 733-787
+HelicityAmplitudes& HelicityAmplitudes::operator*=(double factor) {
+  pppp *= factor;
+  pmmp *= factor;
+  pmpm *= factor;
+  pppm *= factor;
+  ppmm *= factor;
+  return *this;
+}
 
-  const double ured = -sred - tred;
+namespace {
+  std::complex<double> Mpppm_fermion(double sred,
+                                     double tred,
+                                     double ured,
+                                     const std::complex<double>& t_s,
+                                     const std::complex<double>& t_t,
+                                     const std::complex<double>& t_u,
+                                     const std::complex<double>& i_st,
+                                     const std::complex<double>& i_su,
+                                     const std::complex<double>& i_tu) {
+    std::complex<double> output{-1., 0.};
+    output += (-1 / sred - 1 / tred - 1 / ured) * (t_s + t_t + t_u);
+    output += (1 / ured + 1 / (2 * sred * tred)) * i_st;
+    output += (1 / tred + 1 / (2 * sred * ured)) * i_su;
+    output += (1 / sred + 1 / (2 * tred * ured)) * i_tu;
+    return output;
+  }
 
-  if (exclude_loops == 1 || exclude_loops == 3)
-    return 0.;
-  switch (limits(sred, tred, ured)) {
-    case Region::low:  // EFT limit
-      return -4. * (4. * (-1. / 36.) + 3. * (7. / 90.)) * sred * sred;
-    case Region::forward:
-    case Region::backward:  // Forward and backward limit
-      return 1. / (2. * sred * sred) *
-             (2. * sred * sred + (-2. * sred + 4. * sred * sred) * cepgen::epa::utils::B(sred) +
-              (2. * sred - 8. * sred * sred) * cepgen::epa::utils::B(-sred) +
-              (-1. + 2. * sred) * cepgen::epa::utils::T(sred) +
-              (-1. - 2. * sred + 4. * sred * sred) * cepgen::epa::utils::T(-sred));
-    case Region::high:  // high energy limit
-      return 1. + (tred - ured) / sred * log(tred / ured) +
-             (tred * tred + ured * ured) / (2. * sred * sred) * (pow(log(tred / ured), 2) + M_PI * M_PI);
-    case Region::no_limits:
-    default:
-      return Mxxxx_fermion(sred, tred);
+  std::complex<double> Mppmm_fermion(double sred,
+                                     double tred,
+                                     double ured,
+                                     const std::complex<double>& i_st,
+                                     const std::complex<double>& i_su,
+                                     const std::complex<double>& i_tu) {
+    std::complex<double> output{-1., 0.};
+    output += 1 / (2 * sred * tred) * i_st;
+    output += 1 / (2 * sred * ured) * i_su;
+    output += 1 / (2 * tred * ured) * i_tu;
+    return output;
   }
+}  // namespace
+
+std::complex<double> Mxxxx_fermion(double x, double y) {
+  // some auxilliary function used in Mpppp, Mpmpm, Mpmmp.
+  const double z = -x - y;
+  return Mxxxx_fermion(x, y, z, B(y), B(z), T(y), T(z), I(x, y), I(x, z), I(y, z));
 }
 
-std::complex<double> Mpmmp_fermion(double sred, double tred, int exclude_loops) {
-  // M+--+ from Costantini, DeTollis, Pistoni; Nuovo Cim. A2 (1971) 733-787
-  const double ured = -sred - tred;
+namespace {
+  HelicityAmplitudes Mall_fermion(
+      double sred, double tred, double ured, Region region, const std::optional<LoopFunctions>& loops) {
+    switch (region) {
+      case Region::low: {  // EFT limit
+        return HelicityAmplitudes{eft_fermion * sred * sred,
+                                  eft_fermion * tred * tred,
+                                  eft_fermion * ured * ured,
+                                  0.,
+                                  eft_fermion_ppmm * (sred * sred + tred * tred + ured * ured)};
+      }
+      case Region::forward:
+      case Region::backward: {  // Forward and backward limit
+        const auto b_s = B(sred), b_ms = B(-sred), t_s = T(sred), t_ms = T(-sred);
+        const auto me_pp = 1. / (2. * sred * sred) *
+                           (2. * sred * sred + (-2. * sred + 4. * sred * sred) * b_s +
+                            (2. * sred - 8. * sred * sred) * b_ms + (-1. + 2. * sred) * t_s +
+                            (-1. - 2. * sred + 4. * sred * sred) * t_ms),
+                   me_pm = 1. / (2. * sred * sred) *
+                           (2. * sred * sred + (2. * sred + 4. * sred * sred) * b_ms +
+                            (-2. * sred - 8. * sred * sred) * b_s + (-1. - 2. * sred) * t_ms +
+                            (-1. + 2. * sred + 4. * sred * sred) * t_s);
+        const auto forward = region == Region::forward;
+        return HelicityAmplitudes{me_pp,
+                                  forward ? 0. : me_pm,
+                                  forward ? me_pm : 0.,
+                                  0.,
+                                  1. / (2. * sred * sred) *
+                                      (-2. * sred * sred + (-2. * sred * b_s + 2. * sred * b_ms - t_s - t_ms))};
+      }
+      case Region::high:  // high energy limit
+        return HelicityAmplitudes{
+            1. + (tred - ured) / sred * log(tred / ured) +
+                (tred * tred + ured * ured) / (2. * sred * sred) * (pow(log(tred / ured), 2) + M_PI * M_PI),
+            {1. + (sred - ured) / tred * log(-sred / ured) +
+                 (sred * sred + ured * ured) / (2. * tred * tred) * pow(log(-sred / ured), 2),
+             -M_PI * ((sred - ured) / tred + (sred * sred + ured * ured) / (tred * tred) * log(-sred / ured))},
+            {1. + (tred - sred) / ured * log(-tred / sred) +
+                 (sred * sred + tred * tred) / (2. * ured * ured) * pow(log(-tred / sred), 2),
+             M_PI * ((tred - sred) / ured + (sred * sred + tred * tred) / (ured * ured) * log(-tred / sred))},
+            -1.,
+            -1.};
+      case Region::no_limits:
+      default: {
+        const auto& l = *loops;
+        return HelicityAmplitudes{
+            Mxxxx_fermion(sred, tred, ured, l.b_t, l.b_u, l.t_t, l.t_u, l.i_st, l.i_su, l.i_tu),
+            Mxxxx_fermion(tred, sred, ured, l.b_s, l.b_u, l.t_s, l.t_u, l.i_st, l.i_tu, l.i_su),
+            Mxxxx_fermion(ured, tred, sred, l.b_t, l.b_s, l.t_t, l.t_s, l.i_tu, l.i_su, l.i_st),
+            Mpppm_fermion(sred, tred, ured, l.t_s, l.t_t, l.t_u, l.i_st, l.i_su, l.i_tu),
+            Mppmm_fermion(sred, tred, ured, l.i_st, l.i_su, l.i_tu)};
+      }
+    }
+  }
+}  // namespace
 
+HelicityAmplitudes Mall_fermion(double sred, double tred, int exclude_loops, const AmplitudeTables* tables) {
+  // all helicity amplitudes from Costantini, DeTollis, Pistoni; Nuovo Cim. A2 (1971) 733-787
   if (exclude_loops == 1 || exclude_loops == 3)
-    return 0.;
-  switch (limits(sred, tred, ured)) {
-    case Region::low:  // EFT limit
-      return -4. * (4. * (-1. / 36.) + 3. * (7. / 90.)) * tred * tred;
-    case Region::forward:  // Forward limit
-      return 0.;
-    case Region::backward:  // Backward limit
-      return 1. / (2. * sred * sred) *
-             (2. * sred * sred + (2. * sred + 4. * sred * sred) * cepgen::epa::utils::B(-sred) +
-              (-2. * sred - 8. * sred * sred) * cepgen::epa::utils::B(sred) +
-              (-1. - 2. * sred) * cepgen::epa::utils::T(-sred) +
-              (-1. + 2. * sred + 4. * sred * sred) * cepgen::epa::utils::T(sred));
-    case Region::high:  // high energy limit
-      return {1. + (sred - ured) / tred * log(-sred / ured) +
-                  (sred * sred + ured * ured) / (2. * tred * tred) * pow(log(-sred / ured), 2),
-              -M_PI * ((sred - ured) / tred + (sred * sred + ured * ured) / (tred * tred) * log(-sred / ured))};
-    case Region::no_limits:
-    default:
-      return Mxxxx_fermion(tred, sred);
+    return HelicityAmplitudes{};
+
+  const double ured = -sred - tred;
+  const auto region = limits(sred, tred, ured);
+  std::optional<LoopFunctions> loops;  // only evaluated if no asymptotic limit is applicable
+  if (region == Region::no_limits) {
+    if (tables)
+      if (const auto amplitudes = tables->fermion(sred, tred); amplitudes)
+        return *amplitudes;
+    loops.emplace(sred, tred, ured);
   }
+  return Mall_fermion(sred, tred, ured, region, loops);
+}
+
+std::complex<double> Mpppp_fermion(double sred, double tred, int exclude_loops) {
+  // M++++ from Costantini, DeTollis, Pistoni; Nuovo Cim. A2 (1971) 733-787
+  return Mall_fermion(sred, tred, exclude_loops).pppp;
+}
+
+std::complex<double> Mpmmp_fermion(double sred, double tred, int exclude_loops) {
+  // M+--+ from Costantini, DeTollis, Pistoni; Nuovo Cim. A2 (1971) 733-787
+  return Mall_fermion(sred, tred, exclude_loops).pmmp;
 }
 
 std::complex<double> Mpmpm_fermion(double sred, double tred, int exclude_loops) {
   // M+-+- from Costantini, DeTollis, Pistoni; Nuovo Cim. A2 (1971) 733-787
-  const double ured = -sred - tred;
-
-  if (exclude_loops == 1 || exclude_loops == 3)
-    return 0.;
-  switch (limits(sred, tred, ured)) {
-    case Region::low:  // EFT limit
-      return -4. * (4. * (-1. / 36.) + 3. * (7. / 90.)) * ured * ured;
-    case Region::forward:  // Forward limit
-      return 1. / (2. * sred * sred) *
-             (2. * sred * sred + (2. * sred + 4. * sred * sred) * cepgen::epa::utils::B(-sred) +
-              (-2. * sred - 8. * sred * sred) * cepgen::epa::utils::B(sred) +
-              (-1. - 2. * sred) * cepgen::epa::utils::T(-sred) +
-              (-1. + 2. * sred + 4. * sred * sred) * cepgen::epa::utils::T(sred));
-    case Region::backward:  // Backward limit
-      return 0.;
-    case Region::high:  // high energy limit
-      return {1. + (tred - sred) / ured * log(-tred / sred) +
-                  (sred * sred + tred * tred) / (2. * ured * ured) * pow(log(-tred / sred), 2),
-              M_PI * ((tred - sred) / ured + (sred * sred + tred * tred) / (ured * ured) * log(-tred / sred))};
-    case Region::no_limits:
-    default:
-      return Mxxxx_fermion(ured, tred);
-  }
+  return Mall_fermion(sred, tred, exclude_loops).pmpm;
 }
 
 std::complex<double> Mpppm_fermion(double sred, double tred, int exclude_loops) {
   // M+--- from Costantini, DeTollis, Pistoni; Nuovo Cim. A2 (1971) 733-787
-  if (exclude_loops == 1 || exclude_loops == 3)
-    return 0.;
-  const double ured = -sred - tred;
-  switch (limits(sred, tred, ured)) {
-    case Region::low:  // EFT limit
-    case Region::forward:
-    case Region::backward:  // Forward and backward limit
-      return 0.;
-    case Region::high:  // high energy limit
-      return -1.;
-    case Region::no_limits:
-    default: {
-      std::complex<double> output{-1., 0.};
-
-      double temp = -1 / sred - 1 / tred - 1 / ured;
-      output += temp * (cepgen::epa::utils::T(sred) + cepgen::epa::utils::T(tred) + cepgen::epa::utils::T(ured));
-
-      temp = 1 / ured + 1 / (2 * sred * tred);
-      output += temp * cepgen::epa::utils::I(sred, tred);
-
-      temp = 1 / tred + 1 / (2 * sred * ured);
-      output += temp * cepgen::epa::utils::I(sred, ured);
-
-      temp = 1 / sred + 1 / (2 * tred * ured);
-      output += temp * cepgen::epa::utils::I(tred, ured);
-
-      return output;
-    }
-  }
+  return Mall_fermion(sred, tred, exclude_loops).pppm;
 }
 
 std::complex<double> Mppmm_fermion(double sred, double tred, int exclude_loops) {
   // M++-- from Costantini, DeTollis, Pistoni; Nuovo Cim. A2 (1971) 733-787
-
-  const double ured = -sred - tred;
-
-  if (exclude_loops == 1 || exclude_loops == 3)
-    return 0.;
-  switch (limits(sred, tred, ured)) {
-    case Region::low:  // EFT limit
-      return -4. * (4. * (-1. / 36.) + (7. / 90.)) * (sred * sred + tred * tred + ured * ured);
-    case Region::forward:
-    case Region::backward:  // Forward and backward limit
-      return 1. / (2. * sred * sred) *
-             (-2. * sred * sred + (-2. * sred * cepgen::epa::utils::B(sred) + 2. * sred * cepgen::epa::utils::B(-sred) -
-                                   cepgen::epa::utils::T(sred) - cepgen::epa::utils::T(-sred)));
-    case Region::high:  // high energy limit
-      return -1.;
-    case Region::no_limits:
-    default: {
-      std::complex<double> output{-1., 0.};
-
-      double temp = 1 / (2 * sred * tred);
-      output += temp * cepgen::epa::utils::I(sred, tred);
-
-      temp = 1 / (2 * sred * ured);
-      output += temp * cepgen::epa::utils::I(sred, ured);
-
-      temp = 1 / (2 * tred * ured);
-      output += temp * cepgen::epa::utils::I(tred, ured);
-
-      return output;
-    }
-  }
+  return Mall_fermion(sred, tred, exclude_loops).ppmm;
 }
 
 std::complex<double> Mxxxx_vector(double x, double y) {
   // some auxilliary function used in Mpppp, Mpmpm, Mpmmp.
-  std::complex<double> output{-1.5, 0.};
-
   const double z = -x - y;
+  return Mxxxx_vector(x, y, z, B(y), B(z), T(y), T(z), I(x, y), I(x, z), I(y, z));
+}
+
+namespace {
+  HelicityAmplitudes Mall_vector(double sred,
+                                 double tred,
+                                 double ured,
+                                 Region region,
+                                 const std::optional<LoopFunctions>& loops,
+                                 int exclude_loops) {
+    // M+++- and M++-- are proportional to their fermion loop counterpart
+    const auto fermion_amplitudes =
+        exclude_loops == 1 ? HelicityAmplitudes{} : Mall_fermion(sred, tred, ured, region, loops);
+    switch (region) {
+      case Region::low: {  // EFT limit
+        return HelicityAmplitudes{eft_vector * sred * sred,
+                                  eft_vector * tred * tred,
+                                  eft_vector * ured * ured,
+                                  -1.5 * fermion_amplitudes.pppm,
+                                  -1.5 * fermion_amplitudes.ppmm};
+      }
+      case Region::forward:
+      case Region::backward: {  // Forward and backward limit
+        const auto b_s = B(sred), b_ms = B(-sred), t_s = T(sred), t_ms = T(-sred);
+        const auto me_pp = -1.5 + 8. * (sred - 0.25) * (sred - 0.75) / sred * b_s +
+                           (-8. * (sred - 0.25) * (sred - 0.75) / sred + 3.) * b_ms +
+                           4. * (sred - 0.25) * (sred - 0.75) / (sred * sred) * t_s +
+                           (4. * (sred - 0.25) * (sred - 0.75) / (sred * sred) - (8. * sred - 3.) / sred) * t_ms,
+                   me_pm = -1.5 - 8. * (-sred - 0.25) * (-sred - 0.75) / sred * b_ms +
+                           (8. * (-sred - 0.25) * (-sred - 0.75) / sred + 3.) * b_s +
+                           4. * (-sred - 0.25) * (-sred - 0.75) / (sred * sred) * t_ms +
+                           (4. * (-sred - 0.25) * (-sred - 0.75) / (sred * sred) + (-8. * sred - 3.) / sred) * t_s;
+        const auto forward = region == Region::forward;
+        return HelicityAmplitudes{me_pp,
+                                  forward ? 0. : me_pm,
+                                  forward ? me_pm : 0.,
+                                  -1.5 * fermion_amplitudes.pppm,
+                                  -1.5 * fermion_amplitudes.ppmm};
+      }
+      case Region::high:  // high energy limit
+        return HelicityAmplitudes{
+            {-1. * (1.5 + 1.5 * (ured - tred) / sred * log(ured / tred) +
+                    2. * (1. - 0.75 * tred * ured / (sred * sred)) * (pow(log(ured / tred), 2) + M_PI * M_PI) +
+                    2. * sred * sred *
+                        (log(4. * sred) * log(-4. * tred) / (sred * tred) +
+                         log(4. * sred) * log(-4. * ured) / (sred * ured) +
+                         log(-4. * ured) * log(-4. * tred) / (ured * tred))),
+             (2. * M_PI * sred * sred * (log(-4. * ured) / (sred * ured) + log(-4. * tred) / (sred * tred)))},
+            {-(1.5 + 1.5 * (ured - sred) / tred * log(-ured / sred) +
+               2. * (1. - 0.75 * sred * ured / (tred * tred)) * pow(log(-ured / sred), 2) +
+               2. * tred * tred *
+                   (log(4. * sred) * log(-4. * tred) / (sred * tred) +
+                    log(4. * sred) * log(-4. * ured) / (sred * ured) +
+                    log(-4. * ured) * log(-4. * tred) / (ured * tred))),
+             -(1.5 * (sred - ured) / tred * (-M_PI) +
+               2. * (1. - 0.75 * sred * ured / (tred * tred)) * M_PI * 2. * log(-ured / sred) +
+               2. * (-M_PI) * tred * tred * (log(-4. * ured) / (ured * sred) + log(-4. * tred) / (tred * sred)))},
+            {-(1.5 + 1.5 * (tred - sred) / ured * std::log(-tred / sred) +
+               2. * (1. - 0.75 * sred * tred / (ured * ured)) * std::pow(log(-tred / sred), 2) +
+               2. * ured * ured *
+                   (std::log(4. * sred) * std::log(-4. * tred) / (sred * tred) +
+                    std::log(4. * sred) * std::log(-4. * ured) / (sred * ured) +
+                    std::log(-4. * ured) * std::log(-4. * tred) / (ured * tred))),
+             -(1.5 * (sred - tred) / ured * (-M_PI) +
+               2. * (1. - 0.75 * sred * tred / (ured * ured)) * M_PI * 2. * std::log(-tred / sred) +
+               2. * (-M_PI) * ured * ured *
+                   (std::log(-4. * ured) / (ured * sred) + std::log(-4. * tred) / (tred * sred)))},
+            -1.5 * fermion_amplitudes.pppm,
+            -1.5 * fermion_amplitudes.ppmm};
+      case Region::no_limits:
+      default: {
+        const auto& l = *loops;
+        return HelicityAmplitudes{Mxxxx_vector(sred, tred, ured, l.b_t, l.b_u, l.t_t, l.t_u, l.i_st, l.i_su, l.i_tu),
+                                  Mxxxx_vector(tred, sred, ured, l.b_s, l.b_u, l.t_s, l.t_u, l.i_st, l.i_tu, l.i_su),
+                                  Mxxxx_vector(ured, tred, sred, l.b_t, l.b_s, l.t_t, l.t_s, l.i_tu, l.i_su, l.i_st),
+                                  -1.5 * fermion_amplitudes.pppm,
+                                  -1.5 * fermion_amplitudes.ppmm};
+      }
+    }
+  }
+}  // namespace
+
+namespace {
+  /// Vector loop amplitudes retrieved from the interpolation tables, if available
+  std::optional<HelicityAmplitudes> tabulatedVector(const AmplitudeTables& tables,
+                                                    double sred,
+                                                    double tred,
+                                                    int exclude_loops) {
+    auto amplitudes = tables.vector(sred, tred);
+    if (amplitudes && exclude_loops == 1)  // M+++- and M++-- are proportional to their fermion loop counterpart
+      amplitudes->pppm = amplitudes->ppmm = 0.;
+    return amplitudes;
+  }
+}  // namespace
 
-  double temp = -3 * (y - z) / x;
-  output += temp * (cepgen::epa::utils::B(y) - cepgen::epa::utils::B(z));
+HelicityAmplitudes Mall_vector(double sred, double tred, int exclude_loops, const AmplitudeTables* tables) {
+  if (exclude_loops == 2 || exclude_loops == 3)
+    return HelicityAmplitudes{};
 
-  temp = -1 / x * (8 * x - 3 - 6 * y * z / x);
-  output += temp * (cepgen::epa::utils::T(y) + cepgen::epa::utils::T(z));
+  const double ured = -sred - tred;
+  const auto region = limits(sred, tred, ured);
+  std::optional<LoopFunctions> loops;  // only evaluated if no asymptotic limit is applicable
+  if (region == Region::no_limits) {
+    if (tables)
+      if (const auto amplitudes = tabulatedVector(*tables, sred, tred, exclude_loops); amplitudes)
+        return *amplitudes;
+    loops.emplace(sred, tred, ured);
+  }
+  return Mall_vector(sred, tred, ured, region, loops, exclude_loops);
+}
 
-  temp = 1 / x * (8 * x - 6 - 6 * y * z / x) - 4 * (x - 0.25) * (x - 0.75) / (y * z);
-  output += temp * cepgen::epa::utils::I(y, z);
+void Mall_exact(double sred, double tred, HelicityAmplitudes& fermion, HelicityAmplitudes& vector) {
+  const double ured = -sred - tred;
+  const std::optional<LoopFunctions> loops(std::in_place, sred, tred, ured);
+  fermion = Mall_fermion(sred, tred, ured, Region::no_limits, loops);
+  vector = Mall_vector(sred, tred, ured, Region::no_limits, loops, 0);
+}
 
-  temp = -4 * (x - 0.25) * (x - 0.75) / (x * y);
-  output += temp * cepgen::epa::utils::I(x, y);
+namespace {
+  HelicityAmplitudes Mall_loop(LoopSlice::Particle particle,
+                               double sred,
+                               double tred,
+                               Region region,
+                               const std::optional<LoopFunctions>& loops,
+                               int exclude_loops) {
+    const double ured = -sred - tred;
+    return particle == LoopSlice::Particle::fermion ? Mall_fermion(sred, tred, ured, region, loops)
+                                                    : Mall_vector(sred, tred, ured, region, loops, exclude_loops);
+  }
+}  // namespace
+
+LoopSlice::LoopSlice(Particle particle, double sred, int exclude_loops, const AmplitudeTables* tables)
+    : particle_(particle),
+      sred_(sred),
+      exclude_loops_(exclude_loops),
+      tables_(tables),
+      excluded_(exclude_loops == 3 || exclude_loops == (particle == Particle::fermion ? 1 : 2)),
+      low_(sred <= s_eft),
+      high_(sred > s_high),
+      // same thresholds as the limits() region classification, once sred is fixed
+      forward_max_t_(sred <= s_low ? t_low * sred : sred <= s_high ? 1.e-3 : 1.),
+      backward_max_u_(sred <= s_low ? t_low * sred : sred <= s_high ? u_low : 1.) {
+  if (excluded_ || low_)
+    return;
+  b_s_ = B(sred);
+  t_s_ = T(sred);
+  // forward and backward limits only depend on sred
+  forward_ = Mall_loop(particle, sred, 0., Region::forward, std::nullopt, exclude_loops);
+  backward_ = Mall_loop(particle, sred, -sred, Region::backward, std::nullopt, exclude_loops);
+}
 
-  temp = -4 * (x - 0.25) * (x - 0.75) / (x * z);
-  output += temp * cepgen::epa::utils::I(x, z);
+LoopSlice::LowEnergyCoefficients LoopSlice::lowEnergyCoefficients() const {
+  if (excluded_)
+    return LowEnergyCoefficients{};
+  if (particle_ == Particle::fermion)
+    return LowEnergyCoefficients{eft_fermion, eft_fermion_ppmm};
+  // M++-- proportional to its fermion counterpart
+  return LowEnergyCoefficients{eft_vector, exclude_loops_ == 1 ? 0. : -1.5 * eft_fermion_ppmm};
+}
 
-  return output;
+HelicityAmplitudes LoopSlice::operator()(double tred) const {
+  if (excluded_)
+    return HelicityAmplitudes{};
+  const double ured = -sred_ - tred;
+  if (low_)
+    return Mall_loop(particle_, sred_, tred, Region::low, std::nullopt, exclude_loops_);
+  if (-tred < forward_max_t_)
+    return forward_;
+  if (-ured < backward_max_u_)
+    return backward_;
+  if (high_)
+    return Mall_loop(particle_, sred_, tred, Region::high, std::nullopt, exclude_loops_);
+  if (tables_)
+    if (const auto amplitudes = particle_ == Particle::fermion ? tables_->fermion(sred_, tred)
+                                                               : tabulatedVector(*tables_, sred_, tred, exclude_loops_);
+        amplitudes)
+      return *amplitudes;
+  const std::optional<LoopFunctions> loops(std::in_place, b_s_, t_s_, sred_, tred, ured);
+  return Mall_loop(particle_, sred_, tred, Region::no_limits, loops, exclude_loops_);
 }
 
 std::complex<double> Mpppp_vector(double sred, double tred, int exclude_loops) {
-  if (exclude_loops == 2 || exclude_loops == 3)
-    return 0.;
-
-  double ured = -sred - tred;
-  switch (limits(sred, tred, ured)) {
-    case Region::low:  // EFT limit
-      return -4. * (4. * (-5. / 32.) + 3. * (27. / 40.)) * sred * sred;
-    case Region::forward:
-    case Region::backward:  // Forward and backward limit
-      return -1.5 + 8. * (sred - 0.25) * (sred - 0.75) / sred * cepgen::epa::utils::B(sred) +
-             (-8. * (sred - 0.25) * (sred - 0.75) / sred + 3.) * cepgen::epa::utils::B(-sred) +
-             4. * (sred - 0.25) * (sred - 0.75) / (sred * sred) * cepgen::epa::utils::T(sred) +
-             (4. * (sred - 0.25) * (sred - 0.75) / (sred * sred) - (8. * sred - 3.) / sred) *
-                 cepgen::epa::utils::T(-sred);
-    case Region::high:  // high energy limit
-      return {-1. * (1.5 + 1.5 * (ured - tred) / sred * log(ured / tred) +
-                     2. * (1. - 0.75 * tred * ured / (sred * sred)) * (pow(log(ured / tred), 2) + M_PI * M_PI) +
-                     2. * sred * sred *
-                         (log(4. * sred) * log(-4. * tred) / (sred * tred) +
-                          log(4. * sred) * log(-4. * ured) / (sred * ured) +
-                          log(-4. * ured) * log(-4. * tred) / (ured * tred))),
-              (2. * M_PI * sred * sred * (log(-4. * ured) / (sred * ured) + log(-4. * tred) / (sred * tred)))};
-    case Region::no_limits:
-    default:
-      return Mxxxx_vector(sred, tred);
-  }
+  return Mall_vector(sred, tred, exclude_loops).pppp;
 }
 
 std::complex<double> Mpmmp_vector(double sred, double tred, int exclude_loops) {
-  if (exclude_loops == 2 || exclude_loops == 3)
-    return 0.;
-
-  double ured = -sred - tred;
-  switch (limits(sred, tred, ured)) {
-    case Region::low:  // EFT limit
-      return -4. * (4. * (-5. / 32.) + 3. * (27. / 40.)) * tred * tred;
-    case Region::forward:  // Forward limit
-      return 0.;
-    case Region::backward:  // Backward limit
-      return -1.5 - 8. * (-sred - 0.25) * (-sred - 0.75) / sred * cepgen::epa::utils::B(-sred) +
-             (8. * (-sred - 0.25) * (-sred - 0.75) / sred + 3.) * cepgen::epa::utils::B(sred) +
-             4. * (-sred - 0.25) * (-sred - 0.75) / (sred * sred) * cepgen::epa::utils::T(-sred) +
-             (4. * (-sred - 0.25) * (-sred - 0.75) / (sred * sred) + (-8. * sred - 3.) / sred) *
-                 cepgen::epa::utils::T(sred);
-    case Region::high:  // high energy limit
-      return {
-          -(1.5 + 1.5 * (ured - sred) / tred * log(-ured / sred) +
-            2. * (1. - 0.75 * sred * ured / (tred * tred)) * pow(log(-ured / sred), 2) +
-            2. * tred * tred *
-                (log(4. * sred) * log(-4. * tred) / (sred * tred) + log(4. * sred) * log(-4. * ured) / (sred * ured) +
-                 log(-4. * ured) * log(-4. * tred) / (ured * tred))),
-          -(1.5 * (sred - ured) / tred * (-M_PI) +
-            2. * (1. - 0.75 * sred * ured / (tred * tred)) * M_PI * 2. * log(-ured / sred) +
-            2. * (-M_PI) * tred * tred * (log(-4. * ured) / (ured * sred) + log(-4. * tred) / (tred * sred)))};
-    case Region::no_limits:
-    default:
-      return Mxxxx_vector(tred, sred);
-  }
+  return Mall_vector(sred, tred, exclude_loops).pmmp;
 }
 
 std::complex<double> Mpmpm_vector(double sred, double tred, int exclude_loops) {
-  const double ured = -tred - sred;
-
-  if (exclude_loops == 2 || exclude_loops == 3)
-    return 0.;
-  switch (limits(sred, tred, ured)) {
-    case Region::low:  // EFT limit
-      return -4. * (4. * (-5. / 32.) + 3. * (27. / 40.)) * ured * ured;
-    case Region::forward:  // Forward limit
-      return -1.5 - 8. * (-sred - 0.25) * (-sred - 0.75) / sred * cepgen::epa::utils::B(-sred) +
-             (8. * (-sred - 0.25) * (-sred - 0.75) / sred + 3.) * cepgen::epa::utils::B(sred) +
-             4. * (-sred - 0.25) * (-sred - 0.75) / (sred * sred) * cepgen::epa::utils::T(-sred) +
-             (4. * (-sred - 0.25) * (-sred - 0.75) / (sred * sred) + (-8. * sred - 3.) / sred) *
-                 cepgen::epa::utils::T(sred);
-    case Region::backward:  // Backward limit
-      return 0.;
-    case Region::high:  // high energy limit
-      return {-(1.5 + 1.5 * (tred - sred) / ured * std::log(-tred / sred) +
-                2. * (1. - 0.75 * sred * tred / (ured * ured)) * std::pow(log(-tred / sred), 2) +
-                2. * ured * ured *
-                    (std::log(4. * sred) * std::log(-4. * tred) / (sred * tred) +
-                     std::log(4. * sred) * std::log(-4. * ured) / (sred * ured) +
-                     std::log(-4. * ured) * std::log(-4. * tred) / (ured * tred))),
-              -(1.5 * (sred - tred) / ured * (-M_PI) +
-                2. * (1. - 0.75 * sred * tred / (ured * ured)) * M_PI * 2. * std::log(-tred / sred) +
-                2. * (-M_PI) * ured * ured *
-                    (std::log(-4. * ured) / (ured * sred) + std::log(-4. * tred) / (tred * sred)))};
-    case Region::no_limits:
-    default:
-      return Mxxxx_vector(ured, tred);
-  }
+  return Mall_vector(sred, tred, exclude_loops).pmpm;
 }
 
 std::complex<double> Mpppm_vector(double sred, double tred, int exclude_loops) {
-  //double ured=-tred-sred;
+  return Mall_vector(sred, tred, exclude_loops).pppm;
+}
 
-  if (exclude_loops == 2 || exclude_loops == 3)
-    return 0.;
+std::complex<double> Mppmm_vector(double sred, double tred, int exclude_loops) {
+  return Mall_vector(sred, tred, exclude_loops).ppmm;
+}
 
-  /*if (sred < 0.001)  // EFT limit
+template <Helicity H, Loops L>
+std::complex<double> M_fermion(double sred, double tred, const AmplitudeTables* tables) {
+  if constexpr (!hasFermionLoops(L))
     return 0.;
-  if (sred < 10000. && sred > 0.001 && (-tred < 0.0001 * sred || -ured < 0.0001 * sred))  // Forward and backward limit
-    return 0.;*/
-
-  return -1.5 * Mpppm_fermion(sred, tred, exclude_loops);
+  else {
+    const double ured = -sred - tred;
+    if (const auto region = limits(sred, tred, ured); region != Region::no_limits)
+      return Mall_fermion(sred, tred, ured, region, std::nullopt).get<H>();
+    if (tables)
+      if (const auto amplitudes = tables->fermion(sred, tred); amplitudes)
+        return amplitudes->get<H>();
+    if constexpr (H == Helicity::pppp)
+      return Mxxxx_fermion(
+          sred, tred, ured, B(tred), B(ured), T(tred), T(ured), I(sred, tred), I(sred, ured), I(tred, ured));
+    else if constexpr (H == Helicity::pmmp)
+      return Mxxxx_fermion(
+          tred, sred, ured, B(sred), B(ured), T(sred), T(ured), I(sred, tred), I(tred, ured), I(sred, ured));
+    else if constexpr (H == Helicity::pmpm)
+      return Mxxxx_fermion(
+          ured, tred, sred, B(tred), B(sred), T(tred), T(sred), I(tred, ured), I(sred, ured), I(sred, tred));
+    else if constexpr (H == Helicity::pppm)
+      return Mpppm_fermion(sred, tred, ured, T(sred), T(tred), T(ured), I(sred, tred), I(sred, ured), I(tred, ured));
+    else
+      return Mppmm_fermion(sred, tred, ured, I(sred, tred), I(sred, ured), I(tred, ured));
+  }
 }
 
-std::complex<double> Mppmm_vector(double sred, double tred, int exclude_loops) {
-  //double ured = -sred-tred;
-
-  if (exclude_loops == 2 || exclude_loops == 3)
+template <Helicity H, Loops L>
+std::complex<double> M_vector(double sred, double tred, const AmplitudeTables* tables) {
+  if constexpr (!hasVectorLoops(L))
     return 0.;
+  else if constexpr (H == Helicity::pppm || H == Helicity::ppmm)
+    // M+++- and M++-- are proportional to their fermion loop counterpart
+    return -1.5 * M_fermion<H, L>(sred, tred, tables);
+  else {
+    const double ured = -sred - tred;
+    if (const auto region = limits(sred, tred, ured); region != Region::no_limits)
+      return Mall_vector(sred, tred, ured, region, std::nullopt, 1 /* fermion part unused */).get<H>();
+    if (tables)
+      if (const auto amplitudes = tables->vector(sred, tred); amplitudes)
+        return amplitudes->get<H>();
+    if constexpr (H == Helicity::pppp)
+      return Mxxxx_vector(
+          sred, tred, ured, B(tred), B(ured), T(tred), T(ured), I(sred, tred), I(sred, ured), I(tred, ured));
+    else if constexpr (H == Helicity::pmmp)
+      return Mxxxx_vector(
+          tred, sred, ured, B(sred), B(ured), T(sred), T(ured), I(sred, tred), I(tred, ured), I(sred, ured));
+    else
+      return Mxxxx_vector(
+          ured, tred, sred, B(tred), B(sred), T(tred), T(sred), I(tred, ured), I(sred, ured), I(sred, tred));
+  }
+}
+
+#define INSTANTIATE_AMPLITUDES(helicity, loops)                                                                     \
+  template std::complex<double> M_fermion<Helicity::helicity, Loops::loops>(double, double, const AmplitudeTables*); \
+  template std::complex<double> M_vector<Helicity::helicity, Loops::loops>(double, double, const AmplitudeTables*)
+#define INSTANTIATE_ALL_LOOPS(helicity)         \
+  INSTANTIATE_AMPLITUDES(helicity, all);        \
+  INSTANTIATE_AMPLITUDES(helicity, no_fermion); \
+  INSTANTIATE_AMPLITUDES(helicity, no_vector);  \
+  INSTANTIATE_AMPLITUDES(helicity, none)
+INSTANTIATE_ALL_LOOPS(pppp);
+INSTANTIATE_ALL_LOOPS(pmmp);
+INSTANTIATE_ALL_LOOPS(pmpm);
+INSTANTIATE_ALL_LOOPS(pppm);
+INSTANTIATE_ALL_LOOPS(ppmm);
+#undef INSTANTIATE_ALL_LOOPS
+#undef INSTANTIATE_AMPLITUDES
+
+namespace {
+  /// Collection of (sred, tred) points, with their indices grouped by kinematic region
+  class RegionGroups {
+  public:
+    explicit RegionGroups(const std::vector<double>& s, const std::vector<double>& t, double scale)
+        : sred(s.size()), tred(s.size()), ured(s.size()), regions_(s.size()) {
+      for (size_t i = 0; i < s.size(); ++i) {  // vectorisable loop over contiguous arrays
+        sred[i] = s[i] * scale;
+        tred[i] = t[i] * scale;
+        ured[i] = -sred[i] - tred[i];
+        regions_[i] = limits(sred[i], tred[i], ured[i]);
+      }
+      for (size_t i = 0; i < regions_.size(); ++i)
+        indices_.at(static_cast<size_t>(regions_[i])).emplace_back(i);
+    }
 
-  /*if (sred < 0.001)  // EFT limit
-    return -4. * (4. * (-5. / 32.) + (27. / 40.)) * (sred * sred + tred * tred + ured * ured);
-  if (sred < 1.e4 && sred > 1.e-3 && (-tred < 1.e-4 * sred || -ured < 1.e-4 * sred))  // Forward and backward limit
-    return -1.5 / (2. * sred * sred) *
-           (-2. * sred * sred + (-2. * sred * cepgen::epa::utils::B(sred) + 2. * sred * cepgen::epa::utils::B(-sred) -
-                                 cepgen::epa::utils::T(sred) - cepgen::epa::utils::T(-sred)));*/
+    const std::vector<size_t>& operator[](Region region) const { return indices_.at(static_cast<size_t>(region)); }
+
+    std::vector<double> sred, tred, ured;
+
+  private:
+    std::vector<Region> regions_;
+    std::array<std::vector<size_t>, 5> indices_;
+  };
+
+  /// Accumulate the amplitudes of a batch of points, region by region
+  /// \param[in] lookup retrieve the tabulated amplitudes in the exact region, if any
+  template <typename F, typename L>
+  void accumulate(
+      const RegionGroups& groups, double weight, std::vector<HelicityAmplitudes>& output, F&& kernel, L&& lookup) {
+    for (const auto region : {Region::forward, Region::backward, Region::high})
+      for (const auto i : groups[region])
+        output[i] += weight * kernel(groups.sred[i], groups.tred[i], groups.ured[i], region, {});
+    for (const auto i : groups[Region::no_limits]) {
+      if (const auto amplitudes = lookup(groups.sred[i], groups.tred[i]); amplitudes) {
+        output[i] += weight * *amplitudes;
+        continue;
+      }
+      const std::optional<LoopFunctions> loops(std::in_place, groups.sred[i], groups.tred[i], groups.ured[i]);
+      output[i] += weight * kernel(groups.sred[i], groups.tred[i], groups.ured[i], Region::no_limits, loops);
+    }
+  }
+}  // namespace
+
+void Mall_fermion(const std::vector<double>& s,
+                  const std::vector<double>& t,
+                  double scale,
+                  double weight,
+                  int exclude_loops,
+                  std::vector<HelicityAmplitudes>& output,
+                  const AmplitudeTables* tables) {
+  if (exclude_loops == 1 || exclude_loops == 3)
+    return;
+  const RegionGroups groups(s, t, scale);
+  {  // EFT limit; amplitudes are polynomials in the reduced variables
+    for (const auto i : groups[Region::low]) {
+      const auto s2 = groups.sred[i] * groups.sred[i], t2 = groups.tred[i] * groups.tred[i],
+                 u2 = groups.ured[i] * groups.ured[i];
+      auto& amplitudes = output[i];
+      amplitudes.pppp += weight * eft_fermion * s2;
+      amplitudes.pmmp += weight * eft_fermion * t2;
+      amplitudes.pmpm += weight * eft_fermion * u2;
+      amplitudes.ppmm += weight * eft_fermion_ppmm * (s2 + t2 + u2);
+    }
+  }
+  accumulate(groups,
+             weight,
+             output,
+             [](double sred, double tred, double ured, Region region, const std::optional<LoopFunctions>& loops) {
+               return Mall_fermion(sred, tred, ured, region, loops);
+             },
+             [&tables](double sred, double tred) {
+               return tables ? tables->fermion(sred, tred) : std::nullopt;
+             });
+}
 
-  return -1.5 * Mppmm_fermion(sred, tred, exclude_loops);
+void Mall_vector(const std::vector<double>& s,
+                 const std::vector<double>& t,
+                 double scale,
+                 double weight,
+                 int exclude_loops,
+                 std::vector<HelicityAmplitudes>& output,
+                 const AmplitudeTables* tables) {
+  if (exclude_loops == 2 || exclude_loops == 3)
+    return;
+  const RegionGroups groups(s, t, scale);
+  {  // EFT limit; amplitudes are polynomials in the reduced variables
+    static constexpr double eft_vector_ppmm = -1.5 * eft_fermion_ppmm;
+    const auto fermion_weight = exclude_loops == 1 ? 0. : weight;  // M++-- proportional to its fermion counterpart
+    for (const auto i : groups[Region::low]) {
+      const auto s2 = groups.sred[i] * groups.sred[i], t2 = groups.tred[i] * groups.tred[i],
+                 u2 = groups.ured[i] * groups.ured[i];
+      auto& amplitudes = output[i];
+      amplitudes.pppp += weight * eft_vector * s2;
+      amplitudes.pmmp += weight * eft_vector * t2;
+      amplitudes.pmpm += weight * eft_vector * u2;
+      amplitudes.ppmm += fermion_weight * eft_vector_ppmm * (s2 + t2 + u2);
+    }
+  }
+  accumulate(groups,
+             weight,
+             output,
+             [&exclude_loops](
+                 double sred, double tred, double ured, Region region, const std::optional<LoopFunctions>& loops) {
+               return Mall_vector(sred, tred, ured, region, loops, exclude_loops);
+             },
+             [&tables, &exclude_loops](double sred, double tred) {
+               return tables ? tabulatedVector(*tables, sred, tred, exclude_loops) : std::nullopt;
+             });
 }
 
 std::complex<double> Mpppp_eft(double zeta1, double zeta2, double s, double t) {
@@ -371,3 +692,38 @@ std::complex<double> Mppmm_eft(double zeta1, double zeta2, double s, double t) {
   const double u = -s - t;
   return -0.25 * (4. * zeta1 + zeta2) * (s * s + t * t + u * u);
 }
+
+std::complex<double> Mxxxx_spin0even(double x, double /*y*/, double m, double f0, double w_const, double a2) {
+  // s-, t-, or u-channel exchange of a CP-even scalar coupled to photons as phi F_{mu nu} F^{mu nu} / f0, whose
+  // total width is its diphoton width, m^3 / (4 pi f0^2), increased by a constant w_const
+  const auto width = m * m * m / (4. * M_PI * f0 * f0) + w_const;
+  const auto form_factor = a2 > 0. ? a2 / (a2 + std::fabs(x)) : 1.;
+  // factor 1/8 is needed because of the conventions in Costantini, DeTollis, Pistoni
+  return -0.125 * form_factor * x * x / (f0 * f0) / (x - m * m + 1i * m * width);
+}
+
+std::complex<double> Mpppp_spin0even(double x, double y, double m, double f0, double w_const, double a2) {
+  return Mxxxx_spin0even(x, y, m, f0, w_const, a2);
+}
+
+std::complex<double> Mpmmp_spin0even(double x, double y, double m, double f0, double w_const, double a2) {
+  return Mxxxx_spin0even(y, x, m, f0, w_const, a2);
+}
+
+std::complex<double> Mpmpm_spin0even(double x, double y, double m, double f0, double w_const, double a2) {
+  return Mxxxx_spin0even(-x - y, y, m, f0, w_const, a2);
+}
+
+std::complex<double> Mppmm_spin0even(double x, double y, double m, double f0, double w_const, double a2) {
+  return Mpppp_spin0even(x, y, m, f0, w_const, a2) + Mpmmp_spin0even(x, y, m, f0, w_const, a2) +
+         Mpmpm_spin0even(x, y, m, f0, w_const, a2);
+}
+
+std::complex<double> Mpppm_spin0even(double /*x*/,
+                                     double /*y*/,
+                                     double /*m*/,
+                                     double /*f0*/,
+                                     double /*w_const*/,
+                                     double /*a2*/) {
+  return 0.;
+}
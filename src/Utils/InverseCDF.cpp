@@ -0,0 +1,63 @@
+/*
+ *  CepGen: a central exclusive processes event generator
+ *  Copyright (C) 2026  Laurent Forthomme
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <CepGen/Core/Exception.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "CepGenEPA/InverseCDF.h"
+
+using namespace cepgen::epa;
+
+InverseCDF::InverseCDF(const std::vector<double>& x, const std::vector<double>& density)
+    : x_(x), density_(density), cumulative_(x.size(), 0.) {
+  if (x_.size() < 2 || x_.size() != density_.size())
+    throw CG_FATAL("InverseCDF") << "At least two nodes with one density value each are required, got " << x_.size()
+                                 << " nodes and " << density_.size() << " density values.";
+  for (size_t i = 1; i < x_.size(); ++i) {
+    if (x_.at(i) <= x_.at(i - 1))
+      throw CG_FATAL("InverseCDF") << "Nodes must be strictly increasing.";
+    if (density_.at(i) < 0. || density_.at(i - 1) < 0.)
+      throw CG_FATAL("InverseCDF") << "Density must be non-negative.";
+    cumulative_[i] = cumulative_[i - 1] + 0.5 * (density_[i - 1] + density_[i]) * (x_[i] - x_[i - 1]);
+  }
+  if (!(integral() > 0.))
+    throw CG_FATAL("InverseCDF") << "Density integral must be strictly positive, got " << integral() << ".";
+}
+
+double InverseCDF::operator()(double u) const {
+  const auto target = std::clamp(u, 0., 1.) * integral();
+  const auto bin = std::clamp<size_t>(
+      std::upper_bound(cumulative_.begin(), cumulative_.end(), target) - cumulative_.begin(), 1, x_.size() - 1);
+  // solve C(x0 + d) = C0 + p0 d + (p1 - p0) d^2 / (2 h) = target for d in [0, h], in a cancellation-free form
+  const auto h = x_[bin] - x_[bin - 1], p0 = density_[bin - 1], slope = 0.5 * (density_[bin] - p0) / h,
+             remainder = target - cumulative_[bin - 1];
+  const auto discriminant = std::max(p0 * p0 + 4. * slope * remainder, 0.);
+  const auto denominator = p0 + std::sqrt(discriminant);
+  const auto d = denominator > 0. ? 2. * remainder / denominator : 0.;
+  return x_[bin - 1] + std::clamp(d, 0., h);
+}
+
+double InverseCDF::density(double x) const {
+  if (x < x_.front() || x > x_.back())
+    return 0.;
+  const auto bin = std::clamp<size_t>(std::upper_bound(x_.begin(), x_.end(), x) - x_.begin(), 1, x_.size() - 1);
+  const auto frac = (x - x_[bin - 1]) / (x_[bin] - x_[bin - 1]);
+  return density_[bin - 1] + frac * (density_[bin] - density_[bin - 1]);
+}
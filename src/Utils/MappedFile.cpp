@@ -0,0 +1,49 @@
+/*
+ *  CepGen: a central exclusive processes event generator
+ *  Copyright (C) 2026  Laurent Forthomme
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <CepGen/Core/Exception.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "CepGenEPA/MappedFile.h"
+
+using namespace cepgen::epa;
+
+MappedFile::MappedFile(const std::string& path) {
+  const auto descriptor = ::open(path.c_str(), O_RDONLY);
+  if (descriptor < 0)
+    throw CG_FATAL("MappedFile") << "Failed to open file \"" << path << "\": " << std::strerror(errno) << ".";
+  struct stat status;
+  if (::fstat(descriptor, &status) != 0 || status.st_size <= 0) {
+    ::close(descriptor);
+    throw CG_FATAL("MappedFile") << "Failed to retrieve a non-vanishing size for file \"" << path << "\".";
+  }
+  size_ = status.st_size;
+  data_ = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, descriptor, 0);
+  const auto error = errno;  // before it is overwritten by the descriptor closure
+  ::close(descriptor);       // the mapping remains valid after the descriptor is closed
+  if (data_ == MAP_FAILED)
+    throw CG_FATAL("MappedFile") << "Failed to map file \"" << path << "\" in memory: " << std::strerror(error) << ".";
+}
+
+MappedFile::~MappedFile() { ::munmap(data_, size_); }
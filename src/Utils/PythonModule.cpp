@@ -1,6 +1,7 @@
 #include <CepGen/Generator.h>
 
 #include <boost/python.hpp>
+#include <boost/python/stl_iterator.hpp>
 
 #include "CepGenEPA/MatrixElements.h"
 #include "CepGenEPA/TwoPartonFlux.h"
@@ -20,6 +21,11 @@ namespace cepgen::epa::python {
     std::for_each(vec.begin(), vec.end(), [&list](const auto& t) { list.append(t); });
     return list;
   }
+
+  template <typename T>
+  std::vector<T> from_python_iterable(const py::object& iterable) {
+    return std::vector<T>(py::stl_input_iterator<T>(iterable), py::stl_input_iterator<T>());
+  }
 }  // namespace cepgen::epa::python
 
 BOOST_PYTHON_MODULE(libCepGenEPA) {
@@ -27,12 +33,46 @@ BOOST_PYTHON_MODULE(libCepGenEPA) {
 
   cepgen::initialise();
 
-  py::def("sqme_sm", sm_aaaa::sqme, sqme_sm((py::arg("s"), py::arg("t"), py::arg("exclude_loops") = false)));
+  py::def("sqme_sm",
+          static_cast<double (*)(double, double, bool)>(sm_aaaa::sqme),
+          sqme_sm((py::arg("s"), py::arg("t"), py::arg("exclude_loops") = false)));
   py::def(
       "sqme_eft",
-      eft_aaaa::sqme,
+      static_cast<double (*)(double, double, bool, double, double)>(eft_aaaa::sqme),
       sqme_eft((
           py::arg("s"), py::arg("t"), py::arg("exclude_loops") = false, py::arg("zeta1") = 0., py::arg("zeta2") = 0.)));
+  py::def(
+      "sqme_sm_batch",
+      +[](const py::object& s, const py::object& t, bool exclude_loops) {
+        std::vector<double> output;
+        sm_aaaa::sqme_batch(cepgen::epa::python::from_python_iterable<double>(s),
+                            cepgen::epa::python::from_python_iterable<double>(t),
+                            output,
+                            exclude_loops);
+        return cepgen::epa::python::to_python_list(output);
+      },
+      (py::arg("s"), py::arg("t"), py::arg("exclude_loops") = false));
+  py::def(
+      "sqme_eft_batch",
+      +[](const py::object& s, const py::object& t, bool exclude_loops, double zeta1, double zeta2) {
+        std::vector<double> output;
+        eft_aaaa::sqme_batch(cepgen::epa::python::from_python_iterable<double>(s),
+                             cepgen::epa::python::from_python_iterable<double>(t),
+                             output,
+                             exclude_loops,
+                             zeta1,
+                             zeta2);
+        return cepgen::epa::python::to_python_list(output);
+      },
+      (py::arg("s"), py::arg("t"), py::arg("exclude_loops") = false, py::arg("zeta1") = 0., py::arg("zeta2") = 0.));
+  py::def(
+      "sqme_eft_coefficients",
+      +[](double s, double t, bool exclude_loops) {
+        const auto coefficients = eft_aaaa::sqmeCoefficients(s, t, exclude_loops);
+        return cepgen::epa::python::to_python_list(std::vector<double>(coefficients.begin(), coefficients.end()));
+      },
+      (py::arg("s"), py::arg("t"), py::arg("exclude_loops") = false),
+      "Coefficients of the EFT squared matrix element in (1, zeta1, zeta2, zeta1^2, zeta2^2, zeta1*zeta2)");
 
   struct TwoPartonFluxWrap : cepgen::epa::TwoPartonFlux, py::wrapper<cepgen::epa::TwoPartonFlux> {
     std::pair<cepgen::spdgid_t, cepgen::spdgid_t> partons() const override {
@@ -16,9 +16,17 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+// clang-format off
+#include <Python.h>  // first, as it (re)defines some system macros
+// clang-format on
 #include <CepGenPython/Error.h>
 #include <CepGenPython/Functional.h>
 #include <CepGenPython/ObjectPtr.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+#include "CepGenEPA/PythonUtils.h"
 
 namespace cepgen::python {
   std::unique_ptr<Functional> make_functional(const std::string& python_name) {
@@ -37,4 +45,80 @@ namespace cepgen::python {
     }
     throw PY_ERROR << "Failed to import Python function '" << function_path << "' from module '" << module_path << "'.";
   }
+
+  InterpreterLock::InterpreterLock() : state_(static_cast<int>(PyGILState_Ensure())) {}
+
+  InterpreterLock::~InterpreterLock() { PyGILState_Release(static_cast<PyGILState_STATE>(state_)); }
+
+  pid_t fork() {
+    if (!Py_IsInitialized())
+      return ::fork();
+    const auto gil_state = PyGILState_Ensure();  // the interpreter lock and state are to be held across the fork
+    PyOS_BeforeFork();
+    const auto pid = ::fork();
+    const auto error = errno;
+    if (pid == 0)
+      PyOS_AfterFork_Child();
+    else {
+      PyOS_AfterFork_Parent();
+      PyGILState_Release(gil_state);
+    }
+    errno = error;
+    return pid;
+  }
+
+  BatchFunctional::BatchFunctional(const std::string& python_name) : python_name_(python_name) {
+    const auto module_path = python_name.substr(0, python_name.rfind('.')),
+               function_path = python_name.substr(python_name.rfind('.') + 1);
+    const InterpreterLock lock;
+    auto* module = PyImport_ImportModule(module_path.c_str());
+    if (!module)
+      throw PY_ERROR << "Failed to import Python module '" << module_path << "'.";
+    function_ = PyObject_GetAttrString(module, function_path.c_str());
+    Py_DECREF(module);
+    if (!function_ || !PyCallable_Check(function_)) {
+      Py_XDECREF(function_);
+      throw PY_ERROR << "Failed to retrieve a callable '" << function_path << "' from Python module '" << module_path
+                     << "'.";
+    }
+  }
+
+  BatchFunctional::~BatchFunctional() {
+    if (!Py_IsInitialized())  // interpreter already finalised, along with all its objects
+      return;
+    const InterpreterLock lock;
+    Py_DECREF(function_);
+  }
+
+  void BatchFunctional::operator()(const std::vector<double>& batch,
+                                   const std::vector<double>& arguments,
+                                   std::vector<double>& values) const {
+    const InterpreterLock lock;
+    auto* python_arguments = PyTuple_New(arguments.size() + 1);
+    auto* python_batch = PyList_New(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i)
+      PyList_SET_ITEM(python_batch, i, PyFloat_FromDouble(batch[i]));  // steals the reference
+    PyTuple_SET_ITEM(python_arguments, 0, python_batch);
+    for (size_t i = 0; i < arguments.size(); ++i)
+      PyTuple_SET_ITEM(python_arguments, i + 1, PyFloat_FromDouble(arguments[i]));
+    auto* result = PyObject_CallObject(function_, python_arguments);
+    Py_DECREF(python_arguments);
+    if (!result)
+      throw PY_ERROR << "Failed to evaluate '" << python_name_ << "' for a batch of " << batch.size() << " points.";
+    auto* sequence = PySequence_Fast(result, "batch evaluation result is not a sequence");
+    Py_DECREF(result);
+    if (!sequence)
+      throw PY_ERROR << "Batch evaluation of '" << python_name_ << "' did not return a sequence.";
+    if (const auto size = static_cast<size_t>(PySequence_Fast_GET_SIZE(sequence)); size != batch.size()) {
+      Py_DECREF(sequence);
+      throw PY_ERROR << "Batch evaluation of '" << python_name_ << "' returned " << size << " values for "
+                     << batch.size() << " points.";
+    }
+    values.resize(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i)
+      values[i] = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(sequence, i));
+    Py_DECREF(sequence);
+    if (PyErr_Occurred())
+      throw PY_ERROR << "Batch evaluation of '" << python_name_ << "' returned non-numerical values.";
+  }
 }  // namespace cepgen::python
@@ -0,0 +1,91 @@
+#include <CepGen/Core/Exception.h>
+#include <CepGen/Core/ParametersList.h>
+
+#include <cmath>
+
+#include "CepGenEPA/TQuadrature.h"
+
+namespace {
+  /// Fejer's second rule weights on [-1, 1], for the nodes x_k = cos(k pi / n), k = 1, ..., n-1
+  std::vector<double> fejerWeights(size_t n) {
+    std::vector<double> weights;
+    for (size_t k = 1; k < n; ++k) {
+      const auto theta = M_PI * k / n;
+      double sum = 0.;
+      for (size_t j = 1; j <= n / 2; ++j)
+        sum += std::sin((2 * j - 1) * theta) / (2 * j - 1);
+      weights.emplace_back(4. * std::sin(theta) * sum / n);
+    }
+    return weights;
+  }
+}  // namespace
+
+TQuadrature::TQuadrature(const cepgen::ParametersList& params) {
+  const auto plist = description().validate(params);
+  relative_tolerance_ = plist.get<double>("relativeTolerance");
+  const auto num_intervals = plist.get<int>("numIntervals");
+  if (num_intervals < 4 || num_intervals % 4 != 0)
+    throw CG_FATAL("TQuadrature") << "Number of intervals must be a positive multiple of 4, got " << num_intervals
+                                  << ".";
+  const auto n = static_cast<size_t>(num_intervals);
+  const auto fine = fejerWeights(n), coarse = fejerWeights(n / 2);
+  for (size_t k = 1; k < n; ++k) {
+    // x in [0, 1] maps the Fejer node, t = -s x^2 / 2 and dt = -s x dx, with a factor 2 from the t <-> u symmetry
+    const auto x = 0.5 * (1. + std::cos(M_PI * k / n));
+    fractions_.emplace_back(0.5 * x * x);
+    weights_.emplace_back(fine.at(k - 1) * x);
+    coarse_weights_.emplace_back(k % 2 == 0 ? coarse.at(k / 2 - 1) * x : 0.);
+  }
+}
+
+TQuadrature::~TQuadrature() {
+  if (num_above_tolerance_ > 0)
+    CG_WARNING("TQuadrature") << num_above_tolerance_.load() << " out of " << num_integrations_.load()
+                              << " integrations had an error estimate above the " << relative_tolerance_
+                              << " relative tolerance, up to " << max_relative_uncertainty_.load() << ".";
+}
+
+cepgen::ParametersDescription TQuadrature::description() {
+  auto desc = cepgen::ParametersDescription();
+  desc.setName("clenshawCurtis");
+  desc.setDescription("Batched fixed-node t-quadrature for t <-> u symmetric integrands");
+  desc.add("numIntervals", 64).setDescription("number of Fejer rule intervals (one node less is evaluated)");
+  desc.add("relativeTolerance", 1.e-2)
+      .setDescription("relative error estimate above which integrations are counted, and summarised in a warning");
+  return desc;
+}
+
+bool TQuadrature::requested(const cepgen::ParametersList& integrator) {
+  return integrator.name() == description().name();
+}
+
+std::vector<double> TQuadrature::nodes(double s) const {
+  std::vector<double> nodes;
+  nodes.reserve(fractions_.size());
+  for (const auto& fraction : fractions_)
+    nodes.emplace_back(-s * fraction);
+  return nodes;
+}
+
+TQuadrature::Result TQuadrature::integrate(double s, const std::vector<double>& values) const {
+  if (values.size() != fractions_.size())
+    throw CG_FATAL("TQuadrature:integrate") << "Invalid number of integrand values: got " << values.size()
+                                            << ", expected " << fractions_.size() << ".";
+  double fine = 0., coarse = 0.;
+  for (size_t i = 0; i < values.size(); ++i) {
+    fine += weights_[i] * values[i];
+    coarse += coarse_weights_[i] * values[i];
+  }
+  // weights on [-1, 1] are halved when mapped onto x in [0, 1], compensating for the symmetry factor 2
+  const Result result{s * fine, s * std::fabs(fine - coarse)};
+  ++num_integrations_;
+  const auto relative_uncertainty = result.uncertainty > 0. ? result.uncertainty / std::fabs(result.value) : 0.;
+  for (auto max = max_relative_uncertainty_.load(std::memory_order_relaxed); relative_uncertainty > max;)
+    if (max_relative_uncertainty_.compare_exchange_weak(max, relative_uncertainty, std::memory_order_relaxed))
+      break;
+  if (relative_uncertainty > relative_tolerance_ && num_above_tolerance_++ == 0)
+    CG_WARNING("TQuadrature:integrate") << "Error estimate above tolerance for s = " << s << ": " << result.value
+                                        << " +/- " << result.uncertainty
+                                        << ". Further occurrences are summarised at the end of the run.";
+  return result;
+}
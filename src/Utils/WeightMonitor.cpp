@@ -0,0 +1,158 @@
+/*
+ *  CepGen: a central exclusive processes event generator
+ *  Copyright (C) 2026  Laurent Forthomme
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <CepGen/Core/Exception.h>
+#include <CepGen/Modules/DrawerFactory.h>
+#include <CepGen/Utils/Drawer.h>
+
+#include <sstream>
+#include <unordered_map>
+
+#include "CepGenEPA/WeightMonitor.h"
+
+using namespace cepgen::epa;
+
+namespace {
+  std::mutex registry_mutex;
+  std::unordered_map<std::string, std::weak_ptr<WeightMonitor> > registry;  ///< monitors alive, per name
+}  // namespace
+
+WeightMonitor::~WeightMonitor() {
+  if (calls_ == 0)
+    return;
+  CG_INFO("WeightMonitor") << summary();
+  if (!weights_)
+    return;
+  try {
+    DrawerFactory::get().build("text")->draw(
+        *weights_, utils::Drawer::Mode::logx | utils::Drawer::Mode::logy | utils::Drawer::Mode::grid);
+  } catch (const Exception& exc) {
+    CG_WARNING("WeightMonitor") << "Failed to draw the weights distribution: " << exc.message();
+  }
+}
+
+std::shared_ptr<WeightMonitor> WeightMonitor::get(const std::string& name) {
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  if (auto monitor = registry[name].lock())
+    return monitor;
+  std::shared_ptr<WeightMonitor> monitor(new WeightMonitor(name));
+  registry[name] = monitor;
+  return monitor;
+}
+
+void WeightMonitor::book(const Limits& w_range, size_t num_bins) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (weights_)
+    return;
+  if (!w_range.valid() || w_range.min() <= 0. || num_bins == 0)
+    throw CG_FATAL("WeightMonitor:book") << "Invalid binning for the weights distribution: " << num_bins
+                                         << " bins in w range " << w_range << ".";
+  weights_ = std::make_unique<utils::Hist1D>(w_range.generate(num_bins + 1, true), "weights_" + name_);
+  weights_->xAxis().setLabel("$w$ (GeV)");
+  weights_->yAxis().setLabel("Sum of weights");
+}
+
+void WeightMonitor::add(const Record& record) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++calls_;
+  if (record.status == Record::Status::matrixElementZero)
+    ++matrix_element_zeros_;
+  else if (record.status == Record::Status::fluxZero)
+    ++flux_zeros_;
+  matrix_element_time_ += record.matrix_element_time;
+  flux_time_ += record.flux_time;
+  if (weights_)
+    weights_->fill(record.w, record.weight);
+}
+
+void WeightMonitor::Accumulator::add(const Record& record) {
+  ++calls_;
+  if (record.status == Record::Status::matrixElementZero)
+    ++matrix_element_zeros_;
+  else if (record.status == Record::Status::fluxZero)
+    ++flux_zeros_;
+  matrix_element_time_ += record.matrix_element_time;
+  flux_time_ += record.flux_time;
+  weights_.emplace_back(record.w, record.weight);
+  if (weights_.size() >= batch_size_)
+    flush();
+}
+
+void WeightMonitor::Accumulator::flush() {
+  if (calls_ == 0)
+    return;
+  {
+    std::lock_guard<std::mutex> lock(monitor_->mutex_);
+    monitor_->calls_ += calls_;
+    monitor_->matrix_element_zeros_ += matrix_element_zeros_;
+    monitor_->flux_zeros_ += flux_zeros_;
+    monitor_->matrix_element_time_ += matrix_element_time_;
+    monitor_->flux_time_ += flux_time_;
+    if (monitor_->weights_)
+      for (const auto& [w, weight] : weights_)
+        monitor_->weights_->fill(w, weight);
+  }
+  calls_ = matrix_element_zeros_ = flux_zeros_ = 0;
+  matrix_element_time_ = flux_time_ = 0.;
+  weights_.clear();
+}
+
+unsigned long long WeightMonitor::calls() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return calls_;
+}
+
+unsigned long long WeightMonitor::matrixElementZeros() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return matrix_element_zeros_;
+}
+
+unsigned long long WeightMonitor::fluxZeros() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return flux_zeros_;
+}
+
+double WeightMonitor::matrixElementTime() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return matrix_element_time_;
+}
+
+double WeightMonitor::fluxTime() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return flux_time_;
+}
+
+cepgen::utils::Hist1D WeightMonitor::weights() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!weights_)
+    throw CG_FATAL("WeightMonitor:weights") << "Weights distribution was not booked for monitor '" << name_ << "'.";
+  return *weights_;
+}
+
+std::string WeightMonitor::summary() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto per_call = [this](double time) { return calls_ > 0 ? 1.e6 * time / calls_ : 0.; };
+  std::ostringstream os;
+  os << "Weight evaluations summary for monitor '" << name_ << "':\n"
+     << "  calls: " << calls_ << ", of which vanishing matrix element: " << matrix_element_zeros_
+     << ", vanishing flux: " << flux_zeros_ << "\n"
+     << "  matrix element time: " << matrix_element_time_ << " s (" << per_call(matrix_element_time_)
+     << " us/call)\n"
+     << "  flux time: " << flux_time_ << " s (" << per_call(flux_time_) << " us/call)";
+  return os.str();
+}
@@ -0,0 +1,71 @@
+/*
+ *  CepGen: a central exclusive processes event generator
+ *  Copyright (C) 2026  Laurent Forthomme
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <utility>
+
+#include "CepGenEPA/WorkerThread.h"
+
+using namespace cepgen::epa;
+
+WorkerThread::WorkerThread() : thread_(&WorkerThread::run, this) {}
+
+WorkerThread::~WorkerThread() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+  thread_.join();
+}
+
+void WorkerThread::start(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = std::move(task);
+    pending_ = true;
+    error_ = nullptr;
+  }
+  condition_.notify_all();
+}
+
+void WorkerThread::wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  condition_.wait(lock, [this] { return !pending_; });
+  if (auto error = std::exchange(error_, nullptr))
+    std::rethrow_exception(error);
+}
+
+void WorkerThread::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    condition_.wait(lock, [this] { return pending_ || stop_; });
+    if (!pending_)  // stopped with no task left
+      return;
+    lock.unlock();
+    std::exception_ptr error;
+    try {
+      task_();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    lock.lock();
+    error_ = error;
+    pending_ = false;
+    condition_.notify_all();
+  }
+}
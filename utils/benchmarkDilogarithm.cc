@@ -0,0 +1,101 @@
+/*
+ *  CepGen: a central exclusive processes event generator
+ *  Copyright (C) 2024-2026  Laurent Forthomme
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <CepGen/Generator.h>
+#include <CepGen/Utils/ArgumentsParser.h>
+#include <CepGen/Utils/Message.h>
+#include <CepGen/Utils/Timer.h>
+#include <gsl/gsl_sf.h>
+
+#include "CepGenEPA/Dilogarithm.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+  cepgen::Limits x_range;
+  int num_points, num_repetitions;
+  double tolerance;
+  cepgen::initialise();
+  cepgen::ArgumentsParser(argc, argv)
+      .addOptionalArgument("range,r", "real arguments range", &x_range, cepgen::Limits{-1.e3, 1.e3})
+      .addOptionalArgument("num-points,n", "number of arguments to probe", &num_points, 10000)
+      .addOptionalArgument("num-repetitions,t", "number of timing repetitions", &num_repetitions, 100)
+      .addOptionalArgument("tolerance,e", "maximum deviation allowed wrt GSL", &tolerance, 1.e-13)
+      .parse();
+
+  // real arguments span the full range, complex arguments are built in polar form as in utils::F
+  const auto xs = x_range.generate(num_points);
+  vector<double> rs, thetas;
+  vector<complex<double> > zs;
+  for (int i = 0; i < num_points; ++i) {
+    rs.emplace_back(xs.at(i) / max(fabs(x_range.min()), fabs(x_range.max())) * 2.);
+    thetas.emplace_back(-M_PI_2 + M_PI * i / num_points);
+    zs.emplace_back(rs.back() * complex<double>(cos(thetas.back()), sin(thetas.back())));
+  }
+
+  // accuracy test, deviations normalised to max(|Li2|, 1)
+  double max_dev_real = 0., max_dev_complex = 0.;
+  for (int i = 0; i < num_points; ++i) {
+    const auto ref = gsl_sf_dilog(xs.at(i));
+    max_dev_real = max(max_dev_real, fabs(cepgen::epa::utils::dilog(xs.at(i)) - ref) / max(fabs(ref), 1.));
+    gsl_sf_result res_re, res_im;
+    gsl_sf_complex_dilog_e(rs.at(i), thetas.at(i), &res_re, &res_im);
+    const complex<double> ref_cplx{res_re.val, res_im.val};
+    max_dev_complex =
+        max(max_dev_complex, abs(cepgen::epa::utils::dilog(zs.at(i)) - ref_cplx) / max(abs(ref_cplx), 1.));
+  }
+
+  // timing test
+  cepgen::utils::Timer tmr;
+  double sum = 0.;  // accumulated to prevent the evaluations from being optimised away
+  for (int j = 0; j < num_repetitions; ++j)
+    for (const auto& x : xs)
+      sum += gsl_sf_dilog(x);
+  const auto time_gsl_real = tmr.elapsed();
+  tmr.reset();
+  for (int j = 0; j < num_repetitions; ++j)
+    for (const auto& x : xs)
+      sum += cepgen::epa::utils::dilog(x);
+  const auto time_real = tmr.elapsed();
+  tmr.reset();
+  for (int j = 0; j < num_repetitions; ++j)
+    for (int i = 0; i < num_points; ++i) {
+      gsl_sf_result res_re, res_im;
+      gsl_sf_complex_dilog_e(rs.at(i), thetas.at(i), &res_re, &res_im);
+      sum += res_re.val;
+    }
+  const auto time_gsl_complex = tmr.elapsed();
+  tmr.reset();
+  for (int j = 0; j < num_repetitions; ++j)
+    for (const auto& z : zs)
+      sum += cepgen::epa::utils::dilog(z).real();
+  const auto time_complex = tmr.elapsed();
+
+  const auto num_calls = 1.e-9 * num_points * num_repetitions;  // timings in ns/call
+  CG_LOG << "Dilogarithm benchmark for " << num_points << " arguments (checksum: " << sum << "):\n\t"
+         << "real:    max. deviation wrt GSL: " << max_dev_real << ", " << time_real / num_calls << " ns/call (GSL: "
+         << time_gsl_real / num_calls << " ns/call)\n\t"
+         << "complex: max. deviation wrt GSL: " << max_dev_complex << ", " << time_complex / num_calls
+         << " ns/call (GSL: " << time_gsl_complex / num_calls << " ns/call).";
+
+  if (max_dev_real > tolerance || max_dev_complex > tolerance) {
+    CG_ERROR("main") << "Deviation wrt GSL above tolerance (" << tolerance << ").";
+    return -1;
+  }
+  return 0;
+}
@@ -52,10 +52,12 @@ int main(int argc, char* argv[]) {
     const auto partons_flux = cepgen::TwoPartonFluxFactory::get().build(
         cepgen::ParametersList().setName(modelling).set("checkHeader", false));
     auto& graph = graphs.emplace_back();
-    for (const auto& wgg : x_range.generate(num_points, logx)) {
-      const auto flux_wgg = partons_flux->flux(wgg);
-      CG_DEBUG("main") << "Flux at w=" << wgg << ": " << flux_wgg << ".";
-      graph.addPoint(wgg, flux_wgg);
+    const auto wgg = x_range.generate(num_points, logx);
+    vector<double> fluxes;
+    partons_flux->fluxes(wgg, fluxes);
+    for (size_t i = 0; i < wgg.size(); ++i) {
+      CG_DEBUG("main") << "Flux at w=" << wgg.at(i) << ": " << fluxes.at(i) << ".";
+      graph.addPoint(wgg.at(i), fluxes.at(i));
     }
     graph.setTitle(modelling);
     graph.xAxis().setLabel("$w_{\\gamma\\gamma}$ (GeV)");
@@ -50,8 +50,11 @@ int main(int argc, char* argv[]) {
   for (const auto& modelling : modellings) {
     const auto process = cepgen::TwoPartonProcessFactory::get().build(cepgen::ParametersList().setName(modelling));
     auto& graph = graphs.emplace_back();
-    for (const auto& wgg : x_range.generate(num_points, logx))
-      graph.addPoint(wgg, process->matrixElement(wgg));
+    const auto wgg = x_range.generate(num_points, logx);
+    vector<double> matrix_elements;
+    process->matrixElements(wgg, matrix_elements);
+    for (size_t i = 0; i < wgg.size(); ++i)
+      graph.addPoint(wgg.at(i), matrix_elements.at(i));
     graph.setTitle(process->processDescription());
     graph.xAxis().setLabel("$w_{\\gamma\\gamma}$ (GeV)");
     graph.yAxis().setLabel("$\\sigma_{\\gamma\\gamma}$ (pb)");